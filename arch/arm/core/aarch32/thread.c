@@ -398,15 +398,30 @@ void arch_switch_to_main_thread(struct k_thread *main_thread,
 	/* get high address of the stack, i.e. its start (stack grows down) */
 	char *start_of_main_stack;
 
+#ifdef CONFIG_THREAD_LOCAL_STORAGE
+	/* Leave the thread local storage area on top of the stack alone */
+	start_of_main_stack = (char *)main_thread->stack_info.start +
+		main_thread->stack_info.size;
+#else
 	start_of_main_stack =
 		Z_THREAD_STACK_BUFFER(main_stack) + main_stack_size;
+#endif
 
 	start_of_main_stack = (char *)Z_STACK_PTR_ALIGN(start_of_main_stack);
 
 	_current = main_thread;
+#ifdef CONFIG_THREAD_LOCAL_STORAGE
+	z_arm_tls_ptr = main_thread->tls;
+#ifdef CONFIG_USERSPACE
+	z_arm_tls_user_ptr = main_thread->tls;
+#endif
+#endif
 #ifdef CONFIG_TRACING
 	sys_trace_thread_switched_in();
 #endif
+#ifdef CONFIG_THREAD_RUNTIME_STATS
+	z_thread_mark_switched_in();
+#endif
 
 	/* the ready queue cache already contains the main thread */
 
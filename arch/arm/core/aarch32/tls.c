@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <kernel_internal.h>
+#include <kernel_tls.h>
+#include <app_memory/app_memdomain.h>
+#include <sys/libc-hooks.h>
+#include <sys/util.h>
+
+/* Size of the thread control block the thread pointer points to; the
+ * thread local variables follow it, at positive offsets.
+ */
+#define TCB_SIZE	8
+
+/* Loaded with the incoming thread's thread pointer at context switch.
+ * Privileged code only ever uses this one, which user threads cannot
+ * write, since the kernel stores errno through it on their behalf.
+ */
+uintptr_t z_arm_tls_ptr;
+
+#ifdef CONFIG_USERSPACE
+/* Copy of z_arm_tls_ptr for unprivileged threads. A user thread may
+ * overwrite it, but that only redirects its own, MPU checked, accesses
+ * and the next context switch restores it.
+ */
+K_APP_DMEM(z_libc_partition) uintptr_t z_arm_tls_user_ptr;
+#endif
+
+size_t arch_tls_stack_setup(struct k_thread *new_thread, char *stack_ptr)
+{
+	size_t align = MAX(TCB_SIZE, z_tls_data_align());
+	char *tls_start;
+	char *tp;
+
+	tls_start = (char *)ROUND_DOWN(stack_ptr - z_tls_data_size(), align);
+	z_tls_copy(tls_start);
+
+	tp = tls_start - ROUND_UP(TCB_SIZE, align);
+	new_thread->tls = POINTER_TO_UINT(tp);
+
+	return stack_ptr - tp;
+}
@@ -57,6 +57,14 @@ extern FUNC_NORETURN void z_arm_userspace_enter(k_thread_entry_t user_entry,
 
 extern void z_arm_fatal_error(unsigned int reason, const z_arch_esf_t *esf);
 
+#ifdef CONFIG_THREAD_LOCAL_STORAGE
+/* Thread pointer of the current thread, see __aeabi_read_tp() */
+extern uintptr_t z_arm_tls_ptr;
+#ifdef CONFIG_USERSPACE
+extern uintptr_t z_arm_tls_user_ptr;
+#endif
+#endif
+
 #endif /* _ASMLANGUAGE */
 
 #ifdef __cplusplus
@@ -47,6 +47,9 @@ int arch_swap(unsigned int key)
 
 
 	_current = _kernel.ready_q.cache;
+#ifdef CONFIG_THREAD_RUNTIME_STATS
+	z_thread_mark_switched_in();
+#endif
 
 	/*
 	 * Here a "real" arch would load all processor registers for the thread
@@ -84,6 +87,9 @@ void arch_switch_to_main_thread(struct k_thread *main_thread,
 	sys_trace_thread_switched_out();
 
 	_current = _kernel.ready_q.cache;
+#ifdef CONFIG_THREAD_RUNTIME_STATS
+	z_thread_mark_switched_in();
+#endif
 
 	sys_trace_thread_switched_in();
 
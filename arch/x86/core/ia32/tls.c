@@ -0,0 +1,21 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <kernel_internal.h>
+#include <arch/x86/ia32/segmentation.h>
+
+/* Called by arch_swap() for the incoming thread, which then reloads GS
+ * since the CPU caches segment descriptors
+ */
+void z_x86_tls_update_gdt(struct k_thread *thread)
+{
+	struct segment_descriptor *sd = &_gdt.entries[GS_TLS_SEG >> 3];
+
+	sd->base_low = thread->tls & 0xFFFFU;
+	sd->base_mid = (thread->tls >> 16) & 0xFFU;
+	sd->base_hi = (thread->tls >> 24) & 0xFFU;
+}
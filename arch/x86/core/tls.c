@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <kernel_internal.h>
+#include <kernel_tls.h>
+#include <sys/util.h>
+
+size_t arch_tls_stack_setup(struct k_thread *new_thread, char *stack_ptr)
+{
+	/*
+	 * The thread pointer, loaded in GS (IA-32) or FS (Intel64), points
+	 * to a word holding its own value, which the compiler reads to get
+	 * the thread pointer as a plain address. The thread local variables
+	 * are right below it: the linker puts them at negative offsets from
+	 * the thread pointer, as if their size was rounded up to their own
+	 * alignment, not to the one of the thread pointer.
+	 */
+	size_t align = MAX(sizeof(uintptr_t), z_tls_data_align());
+	uintptr_t *self_ptr;
+	char *tls_start;
+
+	self_ptr = (uintptr_t *)ROUND_DOWN(stack_ptr - sizeof(uintptr_t),
+					   align);
+	*self_ptr = POINTER_TO_UINT(self_ptr);
+
+	tls_start = (char *)self_ptr -
+		    ROUND_UP(z_tls_data_size(), z_tls_data_align());
+	z_tls_copy(tls_start);
+
+	new_thread->tls = POINTER_TO_UINT(self_ptr);
+
+	return stack_ptr - tls_start;
+}
@@ -23,7 +23,9 @@ based stack overflow protection or userspace is enabled,
 we additionally create descriptors for the main and double-
 fault IA tasks, needed for userspace privilege elevation and
 double-fault handling. If userspace is enabled, we also create
-flat code/data segments for ring 3 execution.
+flat code/data segments for ring 3 execution. If thread local
+storage is enabled, a last ring 3 data segment is reserved for the
+GS register; its base is updated on every context switch.
 """
 
 import argparse
@@ -171,6 +173,10 @@ def main():
     else:
         num_entries = 3
 
+    use_tls = "CONFIG_THREAD_LOCAL_STORAGE" in syms
+    if use_tls:
+        num_entries += 1
+
     gdt_base = syms["_gdt"]
 
     with open(args.output_gdt, "wb") as fp:
@@ -186,7 +192,8 @@ def main():
         fp.write(create_code_data_entry(0, 0xFFFFF, 0,
                                         FLAGS_GRAN, ACCESS_RW))
 
-        if num_entries >= 5:
+        if "CONFIG_HW_STACK_PROTECTION" in syms or \
+           "CONFIG_USERSPACE" in syms:
             main_tss = syms["_main_tss"]
             df_tss = syms["_df_tss"]
 
@@ -196,7 +203,7 @@ def main():
             # Selector 0x20: double-fault TSS
             fp.write(create_tss_entry(df_tss, 0x67, 0))
 
-        if num_entries == 7:
+        if "CONFIG_USERSPACE" in syms:
             # Selector 0x28: code descriptor, dpl = 3
             fp.write(create_code_data_entry(0, 0xFFFFF, 3,
                                             FLAGS_GRAN, ACCESS_EX | ACCESS_RW))
@@ -205,6 +212,12 @@ def main():
             fp.write(create_code_data_entry(0, 0xFFFFF, 3,
                                             FLAGS_GRAN, ACCESS_RW))
 
+        if use_tls:
+            # Last selector: thread local storage data descriptor, dpl = 3
+            # Its base is set to the thread pointer at context switch.
+            fp.write(create_code_data_entry(0, 0xFFFFF, 3,
+                                            FLAGS_GRAN, ACCESS_RW))
+
 
 if __name__ == "__main__":
     main()
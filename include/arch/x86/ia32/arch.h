@@ -36,6 +36,17 @@
 #define MAIN_TSS	0x18
 #define DF_TSS		0x20
 
+/* Data segment at dpl=3 whose base is the current thread's thread pointer,
+ * last in the GDT
+ */
+#if defined(CONFIG_USERSPACE)
+#define GS_TLS_SEG	(0x38 | 0x03)
+#elif defined(CONFIG_HW_STACK_PROTECTION)
+#define GS_TLS_SEG	(0x28 | 0x03)
+#else
+#define GS_TLS_SEG	(0x18 | 0x03)
+#endif
+
 /**
  * Macro used internally by NANO_CPU_INT_REGISTER and NANO_CPU_INT_REGISTER_ASM.
  * Not meant to be used explicitly by platform, driver or application code.
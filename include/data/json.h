@@ -592,6 +592,133 @@ int json_obj_parse(char *json, size_t len,
 	const struct json_obj_descr *descr, size_t descr_len,
 	void *val);
 
+/** Maximum nesting depth of objects and arrays for the streaming parser */
+#define JSON_STREAM_MAX_DEPTH 16
+
+/**
+ * @brief A value reported by the streaming parser
+ */
+struct json_stream_token {
+	/** One of JSON_TOK_OBJECT_START, JSON_TOK_OBJECT_END,
+	 * JSON_TOK_LIST_START, JSON_TOK_LIST_END, JSON_TOK_STRING,
+	 * JSON_TOK_NUMBER, JSON_TOK_TRUE, JSON_TOK_FALSE or JSON_TOK_NULL.
+	 */
+	enum json_tokens type;
+	/** Location of the value in the document, as a JSON pointer
+	 * (RFC 6901) such as "/sensors/3/name", not NUL terminated.
+	 * Empty for the top level value. Keys are not unescaped.
+	 */
+	const char *path;
+	size_t path_len;
+	/** Name of the value in its parent object, or NULL if the
+	 * value is not a member of an object.
+	 */
+	const char *key;
+	size_t key_len;
+	/** Text of a string (without the quotes and not unescaped) or
+	 * number, not NUL terminated. Empty for other types.
+	 */
+	const char *value;
+	size_t value_len;
+	/** Number of objects and arrays the value is nested in */
+	u8_t depth;
+};
+
+/**
+ * @brief Callback for values reported by the streaming parser
+ *
+ * The token and the strings it points to are only valid during the call.
+ *
+ * @param token The value
+ *
+ * @param user_data User data given to json_stream_init()
+ *
+ * @return 0 to carry on parsing, or a negative error code to abort it.
+ */
+typedef int (*json_stream_cb_t)(const struct json_stream_token *token,
+				void *user_data);
+
+/**
+ * @brief Streaming JSON parser state
+ *
+ * All fields are private, see json_stream_init().
+ */
+struct json_stream {
+	json_stream_cb_t cb;
+	void *user_data;
+	char *buf;
+	size_t buf_size;
+	size_t path_len;
+	size_t len;
+	int err;
+	u8_t state;
+	u8_t depth;
+	u8_t esc;
+	u8_t literal;
+	u8_t literal_pos;
+	u32_t arrays;
+	u16_t outer_path_len[JSON_STREAM_MAX_DEPTH];
+	u32_t index[JSON_STREAM_MAX_DEPTH];
+};
+
+/**
+ * @brief Initialize a streaming JSON parser
+ *
+ * Unlike json_obj_parse(), the streaming parser does not need the whole
+ * document at once nor a descriptor: it takes the document in chunks of
+ * any size with json_stream_feed(), and calls @a cb for every value as
+ * soon as it has been read. Objects and arrays are reported both when
+ * they start and when they end, with their members in between. Any JSON
+ * value can be at the top level of the document.
+ *
+ * The path of the current value and the text of a string or number
+ * which spans several chunks are kept in @a buf, so it must be large
+ * enough for the longest path plus the longest string or number.
+ *
+ * @param stream Parser to initialize
+ *
+ * @param buf Scratch buffer for the parser
+ *
+ * @param buf_size Size of @a buf
+ *
+ * @param cb Function called for every value
+ *
+ * @param user_data Pointer passed to @a cb
+ */
+void json_stream_init(struct json_stream *stream, char *buf, size_t buf_size,
+		      json_stream_cb_t cb, void *user_data);
+
+/**
+ * @brief Feed the next chunk of a document to a streaming JSON parser
+ *
+ * @param stream Parser
+ *
+ * @param data Next chunk of the document, which does not need to be kept
+ * once the call returns
+ *
+ * @param len Length of @a data
+ *
+ * @return 0 on success, -EINVAL if the document is malformed, -ENOMEM if
+ * @a buf given to json_stream_init() is too small or the document is
+ * nested too deeply, or the error returned by the callback. Once an
+ * error has been returned, it is returned again by all further calls.
+ */
+int json_stream_feed(struct json_stream *stream, const char *data,
+		     size_t len);
+
+/**
+ * @brief Signal the end of a document to a streaming JSON parser
+ *
+ * Reports a number at the top level of the document, which can only be
+ * known to be complete at this point.
+ *
+ * @param stream Parser
+ *
+ * @return 0 if a complete document has been parsed, -EINVAL if it is
+ * truncated, or an error as returned by json_stream_feed().
+ */
+int json_stream_finish(struct json_stream *stream);
+
 /**
  * @brief Escapes the string so it can be used to encode JSON objects
  *
@@ -675,6 +802,32 @@ int json_obj_encode(const struct json_obj_descr *descr, size_t descr_len,
 		    const void *val, json_append_bytes_t append_bytes,
 		    void *data);
 
+struct net_buf;
+
+/**
+ * @brief Encodes an object at the end of a chain of network buffers
+ *
+ * The encoded object is added after the data already in the chain,
+ * in the tail room of its fragments; no fragment is allocated. This
+ * avoids both an intermediate buffer and a separate pass to compute the
+ * encoded length. Requires CONFIG_NET_BUF.
+ *
+ * @param descr Pointer to the descriptor array
+ *
+ * @param descr_len Number of elements in the descriptor array
+ *
+ * @param val Struct holding the values
+ *
+ * @param buf First fragment of the chain
+ *
+ * @return 0 if object has been successfully encoded, or -ENOMEM if
+ * the fragments do not have enough tail room, in which case they hold
+ * the start of the encoded object.
+ */
+int json_obj_encode_net_buf(const struct json_obj_descr *descr,
+			    size_t descr_len, const void *val,
+			    struct net_buf *buf);
+
 #ifdef __cplusplus
 }
 #endif
@@ -126,6 +126,60 @@ void z_sys_init_run_level(s32_t level);
 #define SYS_INIT(init_fn, level, prio)					\
 	Z_INIT_ENTRY_DEFINE(Z_SYS_NAME(init_fn), init_fn, NULL, level, prio)
 
+/**
+ * @brief Parallel init descriptor of a device
+ *
+ * @param dev_name Name of the device it applies to
+ * @param deps Names of the devices whose initialization it depends on
+ * @param num_deps Number of entries in @a deps
+ * @param state Initialization state, used during boot
+ * @param dev The device, looked up during boot
+ */
+struct init_parallel {
+	const char *dev_name;
+	const char *const *deps;
+	u8_t num_deps;
+	u8_t state;
+	struct device *dev;
+};
+
+#define Z_INIT_PARALLEL_DEFINE(sym, drv_name, ...)			\
+	static const char *const _CONCAT(sym, _deps)[] = {		\
+		NULL, ##__VA_ARGS__					\
+	};								\
+	static Z_STRUCT_SECTION_ITERABLE(init_parallel, sym) = {	\
+		.dev_name = (drv_name),					\
+		.deps = &_CONCAT(sym, _deps)[1],			\
+		.num_deps = ARRAY_SIZE(_CONCAT(sym, _deps)) - 1,	\
+	}
+
+/**
+ * @def INIT_PARALLEL
+ *
+ * @brief Allow a device to be initialized in parallel with others
+ *
+ * @details With CONFIG_INIT_PARALLEL, this declares that the init
+ * function of device @a drv_name only depends on the devices named in
+ * the remaining arguments, besides those initialized at earlier
+ * levels and the init entries of its level that do not use this
+ * macro.  It can then run concurrently with neighbouring devices that
+ * also use this macro, once all of its dependencies are initialized.
+ * The device's init priority must still place it after its
+ * dependencies, since the devices are initialized in priority order
+ * whenever they cannot be run in parallel (e.g. at the PRE_KERNEL
+ * levels).  Without CONFIG_INIT_PARALLEL this macro does nothing.
+ *
+ * @param drv_name Name of the device, as passed to DEVICE_AND_API_INIT()
+ * @param ... Names of the devices it depends on, if any
+ */
+#ifdef CONFIG_INIT_PARALLEL
+#define INIT_PARALLEL(drv_name, ...)					\
+	Z_INIT_PARALLEL_DEFINE(_CONCAT(__init_parallel_, __COUNTER__),	\
+			       drv_name, ##__VA_ARGS__)
+#else
+#define INIT_PARALLEL(drv_name, ...) struct init_parallel
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -464,6 +464,22 @@ struct _thread_base {
 	int prio_deadline;
 #endif
 
+#ifdef CONFIG_TIMESLICE_PER_THREAD
+	/* Time slice in ticks, or 0 for the system-wide one */
+	int slice_ticks;
+	void (*slice_expired)(struct k_thread *thread, void *data);
+	void *slice_data;
+#endif
+
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	/* Runtime budget and what is left of it, in ticks, or 0 */
+	int cbs_budget;
+	int cbs_remaining;
+
+	/* Budget period, in cycles */
+	int cbs_period;
+#endif
+
 	u32_t order_key;
 
 #ifdef CONFIG_SMP
@@ -530,6 +546,33 @@ struct _thread_userspace_local_data {
 };
 #endif
 
+#ifdef CONFIG_THREAD_RUNTIME_STATS
+/** Number of buckets of the scheduling latency histogram */
+#define K_THREAD_LATENCY_BUCKETS 16
+
+/**
+ * @ingroup thread_apis
+ * Thread runtime statistics, see k_thread_runtime_stats_get()
+ */
+struct k_thread_runtime_stats {
+	/** Hardware cycles spent running the thread */
+	u64_t execution_cycles;
+
+	/** Number of times the thread was switched in */
+	u32_t switches;
+
+	/** Number of times the time slice of the thread expired */
+	u32_t slice_expirations;
+
+	/**
+	 * Time from becoming ready to running, in microseconds: bucket 0
+	 * counts latencies below 1 us, bucket i latencies from 2^(i-1) up
+	 * to 2^i us, and the last bucket all longer ones.
+	 */
+	u32_t latency_hist[K_THREAD_LATENCY_BUCKETS];
+};
+#endif /* CONFIG_THREAD_RUNTIME_STATS */
+
 /**
  * @ingroup thread_apis
  * Thread Structure
@@ -572,12 +615,25 @@ struct k_thread {
 #endif
 
 #ifdef CONFIG_ERRNO
-#ifndef CONFIG_USERSPACE
+#if !defined(CONFIG_USERSPACE) && !defined(CONFIG_ERRNO_IN_TLS)
 	/** per-thread errno variable */
 	int errno_var;
 #endif
 #endif
 
+#ifdef CONFIG_THREAD_LOCAL_STORAGE
+	/** thread pointer, locating the thread local storage area */
+	uintptr_t tls;
+#endif
+
+#ifdef CONFIG_THREAD_RUNTIME_STATS
+	/** runtime statistics */
+	struct k_thread_runtime_stats rt_stats;
+
+	/** k_cycle_get_32() when the thread last became ready, or 0 */
+	u32_t ready_stamp;
+#endif
+
 #if defined(CONFIG_THREAD_STACK_INFO)
 	/** Stack Info */
 	struct _thread_stack_info stack_info;
@@ -848,6 +904,26 @@ __syscall int k_thread_stack_space_get(const struct k_thread *thread,
 				       size_t *unused_ptr);
 #endif
 
+#ifdef CONFIG_THREAD_RUNTIME_STATS
+/**
+ * @brief Get the runtime statistics of a thread
+ *
+ * Copies the number of cycles the thread has run for, including its
+ * current run if it is running, the number of times it was switched
+ * in, and the histogram of the time it waited for a CPU after becoming
+ * ready.
+ *
+ * Cycles are counted with k_cycle_get_32(), so a single run longer
+ * than the period of that counter is undercounted.
+ *
+ * @param thread Thread to get the statistics of
+ * @param stats Filled in with the statistics
+ * @return 0 on success, -EINVAL if an argument is NULL
+ */
+int k_thread_runtime_stats_get(k_tid_t thread,
+			       struct k_thread_runtime_stats *stats);
+#endif /* CONFIG_THREAD_RUNTIME_STATS */
+
 #if (CONFIG_HEAP_MEM_POOL_SIZE > 0)
 /**
  * @brief Assign the system heap as a thread's resource pool
@@ -1196,6 +1272,38 @@ __syscall void k_thread_priority_set(k_tid_t thread, int prio);
  *
  */
 __syscall void k_thread_deadline_set(k_tid_t thread, int deadline);
+
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+/**
+ * @brief Set a runtime budget for a deadline scheduled thread
+ *
+ * This implements a Constant Bandwidth Server: the thread may run for
+ * @a budget every @a period.  Setting a budget also sets the deadline
+ * of the thread to one period from now.  Once a preemptible thread has
+ * run for its whole budget, its budget is refilled and its deadline
+ * postponed by one period, letting other threads of the same priority
+ * with earlier deadlines run.  A thread that wakes up with more budget
+ * left than it can use at its reserved bandwidth before its deadline
+ * starts a new period instead.
+ *
+ * Budgets are enforced with the time slice timer, so they are rounded
+ * up to whole ticks.  Cooperative threads are never preempted, and so
+ * are not held to their budget.
+ *
+ * @note
+ *    @rst
+ *    You should enable :option:`CONFIG_SCHED_DEADLINE_CBS` in your
+ *    project configuration.
+ *    @endrst
+ *
+ * @param thread A thread on which to set the budget
+ * @param budget Runtime per period, in cycle units, or 0 to remove
+ *		 the budget
+ * @param period Budget period, in cycle units
+ */
+__syscall void k_thread_deadline_budget_set(k_tid_t thread, int budget,
+					    int period);
+#endif
 #endif
 
 #ifdef CONFIG_SCHED_CPU_MASK
@@ -1331,6 +1439,41 @@ __syscall void k_thread_resume(k_tid_t thread);
  */
 extern void k_sched_time_slice_set(s32_t slice, int prio);
 
+#ifdef CONFIG_TIMESLICE_PER_THREAD
+/**
+ * @brief Time slice expiration callback
+ *
+ * Invoked from the timer interrupt when the time slice of @a thread
+ * expires, before it is moved behind the other threads of its
+ * priority.
+ *
+ * @param thread Thread whose time slice expired
+ * @param data Value passed to k_thread_time_slice_set()
+ */
+typedef void (*k_thread_timeslice_fn_t)(struct k_thread *thread,
+					void *data);
+
+/**
+ * @brief Set the time slice of a thread.
+ *
+ * A preemptible thread with its own time slice is time sliced with that
+ * length, whatever its priority and the system-wide setting made with
+ * k_sched_time_slice_set().  Long slices suit throughput-oriented
+ * threads, which then get switched out less often, and short ones suit
+ * interactive threads.
+ *
+ * @param thread Thread to operate upon
+ * @param slice Time slice length (in milliseconds), or zero to use the
+ *	  system-wide setting again
+ * @param expired Function to call when the slice expires, or NULL
+ * @param data Argument passed to @a expired
+ *
+ * @return N/A
+ */
+void k_thread_time_slice_set(struct k_thread *thread, s32_t slice,
+			     k_thread_timeslice_fn_t expired, void *data);
+#endif
+
 /** @} */
 
 /**
@@ -1744,7 +1887,6 @@ struct k_timer {
 	{ \
 	.timeout = { \
 		.node = {},\
-		.dticks = 0, \
 		.fn = z_timer_expiration_handler \
 	}, \
 	.wait_q = Z_WAIT_Q_INIT(&obj.wait_q), \
@@ -1944,6 +2086,29 @@ static inline u32_t k_timer_remaining_get(struct k_timer *timer)
 	return k_ticks_to_ms_floor32(k_timer_remaining_ticks(timer));
 }
 
+/**
+ * @brief Set the slack of a timer.
+ *
+ * This routine allows each expiration of the timer to be deferred by
+ * up to @a slack, so that it can be handled together with other
+ * nearby timeouts and the system wakes up less often.  An expiration
+ * never happens early.  Periodic timers keep their period: each
+ * expiration is still scheduled relative to the previous nominal
+ * expiration time.
+ *
+ * The slack should be set while the timer is stopped; it applies from
+ * the next time the timer is started.  It is zero after k_timer_init().
+ *
+ * Without CONFIG_TIMEOUT_SLACK this routine has no effect.
+ *
+ * @param timer     Address of timer.
+ * @param slack     Maximum deferral of each expiration; must be a
+ *                  relative timeout other than K_FOREVER.
+ *
+ * @return N/A
+ */
+__syscall void k_timer_slack_set(struct k_timer *timer, k_timeout_t slack);
+
 #endif /* CONFIG_SYS_CLOCK_EXISTS */
 
 /**
@@ -3041,6 +3206,24 @@ struct k_delayed_work {
 	struct k_work_q *work_q;
 };
 
+struct k_work_q_worker {
+	struct k_thread thread;
+	/* item this worker is running, or NULL */
+	struct k_work *current;
+	/* current was dequeued again by another worker meanwhile */
+	bool rerun;
+};
+
+struct k_work_q_pool {
+	/* shared queue; its thread is not used */
+	struct k_work_q work_q;
+	struct k_spinlock lock;
+	struct k_work_q_worker *workers;
+	k_thread_stack_t *stacks;
+	size_t stack_size;
+	int num_workers;
+};
+
 struct k_work_poll {
 	struct k_work work;
 	struct _poller poller;
@@ -3223,6 +3406,60 @@ extern void k_work_q_user_start(struct k_work_q *work_q,
 				k_thread_stack_t *stack,
 				size_t stack_size, int prio);
 
+/**
+ * @brief Pin each worker of a workqueue pool to its own CPU
+ *
+ * Worker N runs only on CPU (N % CONFIG_MP_NUM_CPUS).  Requires
+ * CONFIG_SCHED_CPU_MASK, and is ignored otherwise.
+ */
+#define K_WORK_Q_POOL_PIN_CPUS BIT(0)
+
+/**
+ * @brief Statically define a workqueue pool.
+ *
+ * A workqueue pool is a workqueue served by several threads.  Work
+ * items are submitted to its @a work_q member with the usual
+ * k_work_submit_to_queue(), k_delayed_work_submit_to_queue() and
+ * k_work_poll_submit_to_queue() calls, and whichever worker is free
+ * takes the next one, so a slow item only holds up its own worker.
+ * Submission and pending semantics are those of a single-threaded
+ * workqueue.  Items may run in a different order than submitted,
+ * but a given item never runs on two workers at the same time: if it
+ * is resubmitted while running, the worker already running it runs
+ * it again.
+ *
+ * The pool must be started with k_work_q_pool_start() before use.
+ *
+ * @param name Name of the workqueue pool.
+ * @param n Number of worker threads.
+ * @param size Size of each worker thread's stack.
+ */
+#define K_WORK_Q_POOL_DEFINE(name, n, size)				\
+	static K_THREAD_STACK_ARRAY_DEFINE(_k_work_q_pool_stacks_##name, \
+					   n, size);			\
+	static struct k_work_q_worker _k_work_q_pool_workers_##name[n]; \
+	struct k_work_q_pool name = {					\
+		.workers = _k_work_q_pool_workers_##name,		\
+		.stacks = _k_work_q_pool_stacks_##name[0],		\
+		.stack_size = size,					\
+		.num_workers = n,					\
+	}
+
+/**
+ * @brief Start a workqueue pool.
+ *
+ * This routine starts the worker threads of a workqueue pool defined
+ * with K_WORK_Q_POOL_DEFINE(), which then run forever.
+ *
+ * @param pool Address of workqueue pool.
+ * @param prio Priority of the worker threads.
+ * @param options Zero, or K_WORK_Q_POOL_PIN_CPUS.
+ *
+ * @return N/A
+ */
+extern void k_work_q_pool_start(struct k_work_q_pool *pool, int prio,
+				u32_t options);
+
 /**
  * @brief Initialize a delayed work item.
  *
@@ -3237,6 +3474,28 @@ extern void k_work_q_user_start(struct k_work_q *work_q,
 extern void k_delayed_work_init(struct k_delayed_work *work,
 				k_work_handler_t handler);
 
+/**
+ * @brief Set the slack of a delayed work item.
+ *
+ * This routine allows the countdown of delayed work item @a work to
+ * complete up to @a slack later than requested, so that it can be
+ * handled together with other nearby timeouts and the system wakes up
+ * less often.  See k_timer_slack_set().
+ *
+ * The slack should be set while the work item is not counting down.
+ * It is zero after k_delayed_work_init().
+ *
+ * Without CONFIG_TIMEOUT_SLACK this routine has no effect.
+ *
+ * @param work Address of delayed work item.
+ * @param slack Maximum deferral of the countdown; must be a relative
+ *              timeout other than K_FOREVER.
+ *
+ * @return N/A
+ */
+extern void k_delayed_work_slack_set(struct k_delayed_work *work,
+				     k_timeout_t slack);
+
 /**
  * @brief Submit a delayed work item.
  *
@@ -3800,6 +4059,10 @@ struct k_msgq {
 	char *write_ptr;
 	/** Number of used messages */
 	u32_t used_msgs;
+	/** Number of slots reserved by k_msgq_put_claim() */
+	u32_t claimed_msgs;
+	/** Senders waiting for the reservation to be committed */
+	_wait_q_t claim_wait_q;
 
 	_OBJECT_TRACING_NEXT_PTR(k_msgq)
 	_OBJECT_TRACING_LINKED_FLAG
@@ -3822,6 +4085,8 @@ struct k_msgq {
 	.read_ptr = q_buffer, \
 	.write_ptr = q_buffer, \
 	.used_msgs = 0, \
+	.claimed_msgs = 0, \
+	.claim_wait_q = Z_WAIT_Q_INIT(&obj.claim_wait_q), \
 	_OBJECT_TRACING_INIT \
 	}
 #define K_MSGQ_INITIALIZER __DEPRECATED_MACRO Z_MSGQ_INITIALIZER
@@ -3943,6 +4208,8 @@ int k_msgq_cleanup(struct k_msgq *msgq);
  * @retval 0 Message sent.
  * @retval -ENOMSG Returned without waiting or queue purged.
  * @retval -EAGAIN Waiting period timed out.
+ * @retval -EBUSY A k_msgq_put_claim() reservation is outstanding and
+ *                @a timeout is K_NO_WAIT.
  */
 __syscall int k_msgq_put(struct k_msgq *msgq, void *data, k_timeout_t timeout);
 
@@ -3966,6 +4233,113 @@ __syscall int k_msgq_put(struct k_msgq *msgq, void *data, k_timeout_t timeout);
  */
 __syscall int k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout);
 
+/**
+ * @brief Send several messages to a message queue.
+ *
+ * This routine sends up to @a num_msgs messages, stored back to back at
+ * @a data, to message queue @a msgq while taking the queue's lock only
+ * once.  Messages are first handed to threads waiting to receive, then
+ * copied into the ring buffer until it is full; the scheduler is invoked
+ * at most once for all of the threads woken up.
+ *
+ * If the queue is full when called, the routine waits up to @a timeout
+ * for room and then sends a single message.
+ *
+ * @note Can be called by ISRs, but @a timeout must be set to K_NO_WAIT.
+ *
+ * @param msgq Address of the message queue.
+ * @param data Pointer to the messages.
+ * @param num_msgs Number of messages at @a data.
+ * @param timeout Waiting period to add a message if the queue is full,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of messages sent (zero only if @a num_msgs is zero).
+ * @retval -ENOMSG Queue full and returned without waiting, or queue
+ *                 purged while waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EBUSY A k_msgq_put_claim() reservation is outstanding and
+ *                @a timeout is K_NO_WAIT.
+ */
+__syscall int k_msgq_put_batch(struct k_msgq *msgq, const void *data,
+			       u32_t num_msgs, k_timeout_t timeout);
+
+/**
+ * @brief Receive several messages from a message queue.
+ *
+ * This routine receives up to @a max_msgs messages from message queue
+ * @a msgq into consecutive slots of @a data, in "first in, first out"
+ * order, while taking the queue's lock only once.  Space freed up is
+ * refilled from threads waiting to send, and the scheduler is invoked
+ * at most once for all of them.
+ *
+ * If the queue is empty when called, the routine waits up to @a timeout
+ * for a message and then receives just that one.
+ *
+ * @note Can be called by ISRs, but @a timeout must be set to K_NO_WAIT.
+ *
+ * @param msgq Address of the message queue.
+ * @param data Address of area to hold up to @a max_msgs messages.
+ * @param max_msgs Maximum number of messages to receive.
+ * @param timeout Waiting period to receive a message if the queue is
+ *                empty, or one of the special values K_NO_WAIT and
+ *                K_FOREVER.
+ *
+ * @return Number of messages received (zero only if @a max_msgs is zero).
+ * @retval -ENOMSG Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+__syscall int k_msgq_get_batch(struct k_msgq *msgq, void *data,
+			       u32_t max_msgs, k_timeout_t timeout);
+
+/**
+ * @brief Reserve space in a message queue to build messages in place.
+ *
+ * This routine reserves up to @a num_msgs contiguous message slots at
+ * the tail of message queue @a msgq and returns their address in
+ * @a data, so that a producer can fill them directly instead of copying
+ * from a separate buffer.  Fewer slots than requested are reserved if
+ * the queue has less free space or if the ring buffer wraps.  The
+ * messages become visible to receivers, in order, when published with
+ * k_msgq_put_commit().
+ *
+ * Only one reservation can be outstanding per queue.  While it is,
+ * k_msgq_put() and k_msgq_put_batch() wait for it to be committed, or
+ * fail with -EBUSY when called with K_NO_WAIT, so claims are intended
+ * for queues with a single producer.  When called from user
+ * mode the queue's ring buffer must be writable by the caller.
+ *
+ * @note Can be called by ISRs.
+ *
+ * @param msgq Address of the message queue.
+ * @param data Address where the start of the reserved slots is stored.
+ * @param num_msgs Number of message slots wanted.
+ *
+ * @return Number of message slots reserved.
+ * @retval -ENOMSG Queue is full.
+ * @retval -EBUSY A reservation is already outstanding.
+ * @retval -EINVAL @a num_msgs is zero.
+ */
+__syscall int k_msgq_put_claim(struct k_msgq *msgq, void **data,
+			       u32_t num_msgs);
+
+/**
+ * @brief Publish messages built in place in a message queue.
+ *
+ * This routine publishes the first @a num_msgs message slots reserved
+ * by k_msgq_put_claim() and releases the rest of the reservation.
+ * Threads waiting to receive are handed messages and woken up, with a
+ * single pass through the scheduler.
+ *
+ * @note Can be called by ISRs.
+ *
+ * @param msgq Address of the message queue.
+ * @param num_msgs Number of reserved slots that were filled in.
+ *
+ * @retval 0 Messages published.
+ * @retval -EINVAL @a num_msgs is larger than the reservation.
+ */
+__syscall int k_msgq_put_commit(struct k_msgq *msgq, u32_t num_msgs);
+
 /**
  * @brief Peek/read a message from a message queue.
  *
@@ -4023,7 +4397,7 @@ __syscall void  k_msgq_get_attrs(struct k_msgq *msgq,
 
 static inline u32_t z_impl_k_msgq_num_free_get(struct k_msgq *msgq)
 {
-	return msgq->max_msgs - msgq->used_msgs;
+	return msgq->max_msgs - msgq->used_msgs - msgq->claimed_msgs;
 }
 
 /**
@@ -4260,6 +4634,8 @@ struct k_pipe {
 	size_t         bytes_used;      /**< # bytes used in buffer */
 	size_t         read_index;      /**< Where in buffer to read from */
 	size_t         write_index;     /**< Where in buffer to write */
+	size_t         put_claimed;     /**< # bytes claimed for writing */
+	size_t         get_claimed;     /**< # bytes claimed for reading */
 	struct k_spinlock lock;		/**< Synchronization lock */
 
 	struct {
@@ -4284,6 +4660,8 @@ struct k_pipe {
 	.bytes_used = 0,                                            \
 	.read_index = 0,                                            \
 	.write_index = 0,                                           \
+	.put_claimed = 0,                                           \
+	.get_claimed = 0,                                           \
 	.lock = {},                                                 \
 	.wait_q = {                                                 \
 		.readers = Z_WAIT_Q_INIT(&obj.wait_q.readers),       \
@@ -4380,6 +4758,8 @@ __syscall int k_pipe_alloc_init(struct k_pipe *pipe, size_t size);
  * @retval -EIO Returned without waiting; zero data bytes were written.
  * @retval -EAGAIN Waiting period timed out; between zero and @a min_xfer
  *                 minus one data bytes were written.
+ * @retval -EBUSY A k_pipe_put_claim() reservation is outstanding and
+ *                @a timeout is K_NO_WAIT.
  */
 __syscall int k_pipe_put(struct k_pipe *pipe, void *data,
 			 size_t bytes_to_write, size_t *bytes_written,
@@ -4403,11 +4783,120 @@ __syscall int k_pipe_put(struct k_pipe *pipe, void *data,
  * @retval -EIO Returned without waiting; zero data bytes were read.
  * @retval -EAGAIN Waiting period timed out; between zero and @a min_xfer
  *                 minus one data bytes were read.
+ * @retval -EBUSY A k_pipe_get_claim() reservation is outstanding and
+ *                @a timeout is K_NO_WAIT.
  */
 __syscall int k_pipe_get(struct k_pipe *pipe, void *data,
 			 size_t bytes_to_read, size_t *bytes_read,
 			 size_t min_xfer, k_timeout_t timeout);
 
+/**
+ * @brief Claim space in a pipe's buffer to write data in place.
+ *
+ * This routine reserves up to @a bytes_to_write contiguous bytes of free
+ * space in the ring buffer of @a pipe and returns their address in
+ * @a data, so that a producer can format or DMA data directly into pipe
+ * storage.  The data becomes visible to readers when k_pipe_put_finish()
+ * is called.
+ *
+ * The routine waits up to @a timeout for at least @a min_xfer contiguous
+ * bytes to become free.  Space never spans the end of the ring buffer,
+ * so when the free space wraps the claim is also satisfied by the part
+ * up to the end of the buffer, even if it is shorter than @a min_xfer;
+ * claim again after finishing to get the rest.
+ *
+ * Only one write claim can be outstanding per pipe.  While it is,
+ * k_pipe_put() waits for k_pipe_put_finish(), or fails with -EBUSY when
+ * called with K_NO_WAIT.  When called from user mode the
+ * pipe's buffer must be writable by the caller.
+ *
+ * @param pipe Address of the pipe.
+ * @param data Address where the start of the claimed space is stored.
+ * @param bytes_to_write Maximum number of bytes to claim.
+ * @param bytes_claimed Address of area to hold the number of bytes
+ *                      claimed.
+ * @param min_xfer Minimum number of bytes to claim.
+ * @param timeout Waiting period to wait for space,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Space was claimed.
+ * @retval -EINVAL Invalid parameters, or the pipe has no buffer.
+ * @retval -EIO Returned without waiting; nothing was claimed.
+ * @retval -EAGAIN Waiting period timed out; nothing was claimed.
+ * @retval -EBUSY A write claim is already outstanding.
+ */
+__syscall int k_pipe_put_claim(struct k_pipe *pipe, u8_t **data,
+			       size_t bytes_to_write, size_t *bytes_claimed,
+			       size_t min_xfer, k_timeout_t timeout);
+
+/**
+ * @brief Commit data written in place into a pipe's buffer.
+ *
+ * This routine makes the first @a bytes_written bytes of the space
+ * claimed by k_pipe_put_claim() available to readers, handing them to
+ * waiting readers if there are any, and releases the rest of the claim.
+ *
+ * @param pipe Address of the pipe.
+ * @param bytes_written Number of bytes that were written.
+ *
+ * @retval 0 Data committed.
+ * @retval -EINVAL @a bytes_written exceeds the claimed space.
+ */
+__syscall int k_pipe_put_finish(struct k_pipe *pipe, size_t bytes_written);
+
+/**
+ * @brief Claim data in a pipe's buffer to read it in place.
+ *
+ * This routine returns in @a data the address of up to @a bytes_to_read
+ * contiguous bytes of data at the head of the ring buffer of @a pipe, so
+ * that a consumer can parse them without copying.  The data is released
+ * when k_pipe_get_finish() is called.  Data still held by waiting
+ * writers is not visible until it reaches the ring buffer.
+ *
+ * The routine waits up to @a timeout for at least @a min_xfer contiguous
+ * bytes of data.  Data never spans the end of the ring buffer, so when
+ * it wraps the claim is also satisfied by the part up to the end of the
+ * buffer, even if it is shorter than @a min_xfer.
+ *
+ * Only one read claim can be outstanding per pipe.  While it is,
+ * k_pipe_get() waits for k_pipe_get_finish(), or fails with -EBUSY when
+ * called with K_NO_WAIT.  When called from user mode the
+ * pipe's buffer must be readable by the caller.
+ *
+ * @param pipe Address of the pipe.
+ * @param data Address where the start of the claimed data is stored.
+ * @param bytes_to_read Maximum number of bytes to claim.
+ * @param bytes_claimed Address of area to hold the number of bytes
+ *                      claimed.
+ * @param min_xfer Minimum number of bytes to claim.
+ * @param timeout Waiting period to wait for data,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Data was claimed.
+ * @retval -EINVAL Invalid parameters, or the pipe has no buffer.
+ * @retval -EIO Returned without waiting; nothing was claimed.
+ * @retval -EAGAIN Waiting period timed out; nothing was claimed.
+ * @retval -EBUSY A read claim is already outstanding.
+ */
+__syscall int k_pipe_get_claim(struct k_pipe *pipe, u8_t **data,
+			       size_t bytes_to_read, size_t *bytes_claimed,
+			       size_t min_xfer, k_timeout_t timeout);
+
+/**
+ * @brief Release data read in place from a pipe's buffer.
+ *
+ * This routine frees the first @a bytes_read bytes of the data claimed
+ * by k_pipe_get_claim(), refilling the buffer from waiting writers if
+ * there are any.  Unreleased data stays at the head of the pipe.
+ *
+ * @param pipe Address of the pipe.
+ * @param bytes_read Number of bytes that were consumed.
+ *
+ * @retval 0 Data released.
+ * @retval -EINVAL @a bytes_read exceeds the claimed data.
+ */
+__syscall int k_pipe_get_finish(struct k_pipe *pipe, size_t bytes_read);
+
 /**
  * @brief Write memory block to a pipe.
  *
@@ -4451,6 +4940,19 @@ __syscall size_t k_pipe_write_avail(struct k_pipe *pipe);
  * @cond INTERNAL_HIDDEN
  */
 
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+/* Per-CPU cache of free blocks in front of a memory slab */
+struct z_mem_slab_magazine {
+	struct k_spinlock lock;
+	u32_t count;
+	u32_t alloc_hits;
+	u32_t alloc_misses;
+	u32_t free_hits;
+	u32_t free_misses;
+	void *blocks[CONFIG_MEM_SLAB_MAGAZINE_SIZE];
+};
+#endif
+
 struct k_mem_slab {
 	_wait_q_t wait_q;
 	u32_t num_blocks;
@@ -4459,6 +4961,12 @@ struct k_mem_slab {
 	char *free_list;
 	u32_t num_used;
 
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+	/* number of allocators about to wait or waiting for a block */
+	atomic_t waiters;
+	struct z_mem_slab_magazine magazines[CONFIG_MP_NUM_CPUS];
+#endif
+
 	_OBJECT_TRACING_NEXT_PTR(k_mem_slab)
 	_OBJECT_TRACING_LINKED_FLAG
 };
@@ -4583,7 +5091,18 @@ extern void k_mem_slab_free(struct k_mem_slab *slab, void **mem);
  */
 static inline u32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
 {
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+	/* num_used also counts the free blocks cached in magazines */
+	u32_t cached = 0U;
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		cached += slab->magazines[i].count;
+	}
+
+	return slab->num_used - cached;
+#else
 	return slab->num_used;
+#endif
 }
 
 /**
@@ -4598,9 +5117,42 @@ static inline u32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
  */
 static inline u32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
 {
-	return slab->num_blocks - slab->num_used;
+	return slab->num_blocks - k_mem_slab_num_used_get(slab);
 }
 
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+/**
+ * @brief Memory slab magazine statistics
+ */
+struct k_mem_slab_magazine_stats {
+	/** Allocations served from a per-CPU magazine */
+	u32_t alloc_hits;
+	/** Allocations that went to the shared free list */
+	u32_t alloc_misses;
+	/** Frees absorbed by a per-CPU magazine */
+	u32_t free_hits;
+	/** Frees that went to the shared free list */
+	u32_t free_misses;
+	/** Free blocks currently cached in magazines */
+	u32_t cached;
+};
+
+/**
+ * @brief Get per-CPU magazine statistics of a memory slab.
+ *
+ * This routine sums the magazine hit and miss counters of all CPUs for
+ * @a slab.  The counters are not sampled atomically with respect to
+ * concurrent allocations.
+ *
+ * @param slab Address of the memory slab.
+ * @param stats Address of area to hold the statistics.
+ *
+ * @return N/A
+ */
+void k_mem_slab_magazine_stats_get(struct k_mem_slab *slab,
+				   struct k_mem_slab_magazine_stats *stats);
+#endif
+
 /** @} */
 
 /**
@@ -4640,11 +5192,30 @@ void k_heap_init(struct k_heap *h, void *mem, size_t bytes);
  */
 void *k_heap_alloc(struct k_heap *h, size_t bytes, k_timeout_t timeout);
 
+/**
+ * @brief Allocate aligned memory from a k_heap
+ *
+ * Behaves in all ways like k_heap_alloc(), except that the returned
+ * memory (if available) will have a starting address in memory which
+ * is a multiple of the specified power-of-two alignment value in
+ * bytes.  The resulting memory can be returned to the heap using
+ * k_heap_free().
+ *
+ * @param h Heap from which to allocate
+ * @param align Alignment in bytes, must be a power of two
+ * @param bytes Desired size of block to allocate
+ * @param timeout How long to wait, or K_NO_WAIT
+ * @return A pointer to valid heap memory, or NULL
+ */
+void *k_heap_aligned_alloc(struct k_heap *h, size_t align, size_t bytes,
+			   k_timeout_t timeout);
+
 /**
  * @brief Free memory allocated by k_heap_alloc()
  *
  * Returns the specified memory block, which must have been returned
- * from k_heap_alloc(), to the heap for use by other callers.  Passing
+ * from k_heap_alloc() or k_heap_aligned_alloc(), to the heap for use
+ * by other callers.  Passing
  * a NULL block is legal, and has no effect.
  *
  * @param h Heap to which to return the memory
@@ -4652,6 +5223,28 @@ void *k_heap_alloc(struct k_heap *h, size_t bytes, k_timeout_t timeout);
  */
 void k_heap_free(struct k_heap *h, void *mem);
 
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+/**
+ * @brief Get runtime statistics of a k_heap
+ *
+ * Fills in @a stats with the current and peak usage of the heap, see
+ * sys_heap_runtime_stats_get().  The snapshot is taken with the heap
+ * locked and so is consistent.
+ *
+ * @param h Heap to inspect
+ * @param stats Structure to fill in
+ */
+void k_heap_runtime_stats_get(struct k_heap *h,
+			      struct sys_heap_runtime_stats *stats);
+
+/**
+ * @brief Reset the peak usage of a k_heap
+ *
+ * @param h Heap to reset
+ */
+void k_heap_runtime_stats_reset_max(struct k_heap *h);
+#endif
+
 /**
  * @brief Define a static k_heap
  *
@@ -4977,6 +5570,54 @@ struct k_poll_event {
 	.obj = event_obj, \
 	}
 
+/* public - persistent poll set object */
+struct k_poll_set {
+	/** PRIVATE - DO NOT TOUCH */
+	struct k_poll_event *events;
+	int num_events;
+
+	/* events whose condition has been met, rechecked and reported
+	 * by k_poll_set_wait()
+	 */
+	sys_dlist_t ready;
+
+	_wait_q_t wait_q;
+
+	/* poller of every event registered with an object */
+	struct _poller poller;
+};
+
+/**
+ * @internal
+ */
+extern int z_poll_set_event_cb(struct k_poll_event *event, u32_t state);
+
+#define Z_POLL_SET_INITIALIZER(obj, set_events, set_num_events) \
+	{ \
+	.events = set_events, \
+	.num_events = set_num_events, \
+	.ready = SYS_DLIST_STATIC_INIT(&obj.ready), \
+	.wait_q = Z_WAIT_Q_INIT(&obj.wait_q), \
+	.poller = { .cb = z_poll_set_event_cb }, \
+	}
+
+/**
+ * @brief Statically define and initialize a poll set.
+ *
+ * The poll set can be accessed outside the module where it is defined
+ * using:
+ *
+ * @code extern struct k_poll_set <name>; @endcode
+ *
+ * @param name Name of the poll set.
+ * @param max_events Maximum number of events the set can hold.
+ */
+#define K_POLL_SET_DEFINE(name, max_events) \
+	static struct k_poll_event _k_poll_set_events_##name[max_events]; \
+	struct k_poll_set name = \
+		Z_POLL_SET_INITIALIZER(name, _k_poll_set_events_##name, \
+				       max_events)
+
 /**
  * @brief Initialize one struct k_poll_event instance
  *
@@ -5106,6 +5747,91 @@ __syscall void k_poll_signal_check(struct k_poll_signal *signal,
 
 __syscall int k_poll_signal_raise(struct k_poll_signal *signal, int result);
 
+/**
+ * @brief Initialize a poll set.
+ *
+ * A poll set is an alternative to k_poll() for threads that repeatedly
+ * wait on the same, possibly large, group of objects.  Events are
+ * added to the set once with k_poll_set_add() and stay registered with
+ * their objects until removed; an object becoming available puts its
+ * event on the set's ready list.  k_poll_set_wait() then only looks at
+ * the ready list, so its cost depends on the number of ready events
+ * rather than on the number of events in the set.
+ *
+ * Readiness is level-triggered, as with k_poll(): an event reported by
+ * k_poll_set_wait() is checked again by the next call, and reported
+ * again if its condition still holds.
+ *
+ * @param set Address of the poll set.
+ * @param events Storage for the set's events.  It is owned by the
+ *        kernel until the set is no longer used, and must not be
+ *        accessible from user mode.
+ * @param num_events Number of entries in @a events.
+ *
+ * @return N/A
+ */
+extern void k_poll_set_init(struct k_poll_set *set,
+			    struct k_poll_event *events, int num_events);
+
+/**
+ * @brief Add an event to a poll set.
+ *
+ * This routine starts watching @a obj for the condition given by
+ * @a type.  If the condition is already met, the event is ready right
+ * away.
+ *
+ * @param set Address of the poll set.
+ * @param type The type of event, one of the K_POLL_TYPE_xxx values
+ *        other than K_POLL_TYPE_IGNORE.
+ * @param obj Kernel object or poll signal.
+ * @param tag Tag reported with the event, only the low 8 bits are kept.
+ *
+ * @retval 0 Event added.
+ * @retval -EALREADY @a obj is already in the set.
+ * @retval -ENOMEM The set is full.
+ * @retval -EINVAL Bad parameters (user mode only)
+ */
+__syscall int k_poll_set_add(struct k_poll_set *set, u32_t type, void *obj,
+			     u32_t tag);
+
+/**
+ * @brief Remove an event from a poll set.
+ *
+ * @param set Address of the poll set.
+ * @param obj Object whose event is to be removed.
+ *
+ * @retval 0 Event removed.
+ * @retval -ENOENT @a obj is not in the set.
+ */
+__syscall int k_poll_set_remove(struct k_poll_set *set, void *obj);
+
+/**
+ * @brief Wait for events of a poll set to be ready.
+ *
+ * This routine waits until at least one event of the set is ready,
+ * then copies up to @a max ready events to @a ready and returns their
+ * number.  Each copy has its type, tag, object and state fields set,
+ * the state being a bitfield of K_POLL_STATE_xxx values; the copies
+ * are not registered with anything and can be discarded freely.  When
+ * more than @a max events are ready, successive calls report them
+ * round-robin.
+ *
+ * As with k_poll(), the objects are not taken on behalf of the caller.
+ *
+ * @param set Address of the poll set.
+ * @param ready Array receiving the ready events.
+ * @param max Number of entries in @a ready, greater than zero.
+ * @param timeout Waiting period for an event to be ready,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of events copied to @a ready, or a negative error code.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EINVAL Bad parameters (user mode only)
+ */
+__syscall int k_poll_set_wait(struct k_poll_set *set,
+			      struct k_poll_event *ready, int max,
+			      k_timeout_t timeout);
+
 /**
  * @internal
  */
@@ -120,6 +120,11 @@ struct _cpu {
 #ifdef CONFIG_TIMESLICING
 	/* number of ticks remaining in current time slice */
 	int slice_ticks;
+
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	/* thread whose runtime budget the time slice counts down */
+	struct k_thread *cbs_thread;
+#endif
 #endif
 
 	u8_t id;
@@ -128,6 +133,17 @@ struct _cpu {
 	/* True when _current is allowed to context switch */
 	u8_t swap_ok;
 #endif
+
+#ifdef CONFIG_THREAD_RUNTIME_STATS
+	/* thread last switched in on this CPU, and when */
+	struct k_thread *usage_thread;
+	u32_t usage_start;
+
+	/* odd while this CPU updates the above or the statistics of
+	 * the threads it switches, see k_thread_runtime_stats_get()
+	 */
+	atomic_t usage_seq;
+#endif
 };
 
 typedef struct _cpu _cpu_t;
@@ -219,8 +235,23 @@ struct _timeout;
 typedef void (*_timeout_func_t)(struct _timeout *t);
 
 struct _timeout {
+#ifdef CONFIG_TIMEOUT_QUEUE_SCALABLE
+	struct rbnode node;
+	/* absolute expiration tick, zero when not queued */
+	u64_t expiry;
+	u32_t order_key;
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	/* CPU whose queue holds (or last held) this timeout */
+	u8_t cpu;
+#endif
+#else
 	sys_dnode_t node;
 	s32_t dticks;
+#endif
+#ifdef CONFIG_TIMEOUT_SLACK
+	/* ticks by which expiry may be deferred to share a wakeup */
+	u32_t slack;
+#endif
 	_timeout_func_t fn;
 };
 
@@ -228,8 +259,23 @@ struct _timeout {
 
 struct k_spinlock {
 #ifdef CONFIG_SMP
+#ifdef CONFIG_SPINLOCK_TICKET
+	/* Next ticket to hand out, and ticket of the current holder */
+	atomic_t next;
+	atomic_t owner;
+#else
 	atomic_t locked;
 #endif
+#endif
+
+#ifdef CONFIG_SPINLOCK_STATS
+	/* Number of acquisitions, of acquisitions which found the lock
+	 * held, and of spin loop iterations those waited for
+	 */
+	u32_t acquired;
+	u32_t contended;
+	u32_t spins;
+#endif
 
 #ifdef CONFIG_SPIN_VALIDATE
 	/* Stores the thread that holds the lock with the locking CPU
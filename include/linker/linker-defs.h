@@ -303,6 +303,16 @@ extern char z_priv_stacks_ram_start[];
 extern char z_priv_stacks_ram_end[];
 #endif /* CONFIG_USERSPACE */
 
+/* Initial image, size and alignment of the thread local storage area.
+ * Sizes and alignment are symbol values, not addresses.
+ */
+#ifdef CONFIG_THREAD_LOCAL_STORAGE
+extern char __tdata_start[];
+extern char __tdata_size[];
+extern char __tls_size[];
+extern char __tls_align[];
+#endif /* CONFIG_THREAD_LOCAL_STORAGE */
+
 #endif /* ! _ASMLANGUAGE */
 
 #endif /* ZEPHYR_INCLUDE_LINKER_LINKER_DEFS_H_ */
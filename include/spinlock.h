@@ -49,6 +49,69 @@ struct k_spinlock;
  */
 typedef struct k_spinlock_key k_spinlock_key_t;
 
+#ifdef CONFIG_SMP
+/* Internal function: spins until the lock is held by the caller, and
+ * returns the number of spin loop iterations it took.
+ */
+static ALWAYS_INLINE u32_t z_spin_acquire(struct k_spinlock *l)
+{
+	u32_t spins = 0U;
+
+#ifdef CONFIG_SPINLOCK_TICKET
+	/* CPUs get the lock in the order they asked for it, and spin
+	 * on a value which only changes once per release.
+	 */
+	atomic_val_t ticket = atomic_inc(&l->next);
+
+	while (atomic_get(&l->owner) != ticket) {
+		spins++;
+	}
+#else
+	while (!atomic_cas(&l->locked, 0, 1)) {
+		spins++;
+	}
+#endif
+	return spins;
+}
+
+/* Internal function: hands the lock to the next CPU waiting for it */
+static ALWAYS_INLINE void z_spin_drop(struct k_spinlock *l)
+{
+#ifdef CONFIG_SPINLOCK_TICKET
+	(void)atomic_inc(&l->owner);
+#else
+	/* Strictly we don't need atomic_clear() here (which is an
+	 * exchange operation that returns the old value).  We are always
+	 * setting a zero and (because we hold the lock) know the existing
+	 * state won't change due to a race.  But some architectures need
+	 * a memory barrier when used like this, and we don't have a
+	 * Zephyr framework for that.
+	 */
+	atomic_clear(&l->locked);
+#endif
+}
+#endif /* CONFIG_SMP */
+
+#ifdef CONFIG_SPINLOCK_STATS
+struct z_spinlock_stats_entry {
+	const char *name;
+	struct k_spinlock *lock;
+};
+
+/* Internal macro: lists a kernel spinlock, with its statistics, in
+ * the "kernel locks" shell command
+ */
+#define Z_SPINLOCK_STATS_DEFINE(lock_name, spinlock) \
+	static const Z_STRUCT_SECTION_ITERABLE(z_spinlock_stats_entry, \
+					       _CONCAT(z_spin_stats_, \
+						       lock_name)) = { \
+		.name = STRINGIFY(lock_name), \
+		.lock = &spinlock, \
+	}
+#else
+#define Z_SPINLOCK_STATS_DEFINE(lock_name, spinlock)
+#endif /* CONFIG_SPINLOCK_STATS */
+
 /**
  * @brief Lock a spinlock
  *
@@ -93,8 +156,18 @@ static ALWAYS_INLINE k_spinlock_key_t k_spin_lock(struct k_spinlock *l)
 #endif
 
 #ifdef CONFIG_SMP
-	while (!atomic_cas(&l->locked, 0, 1)) {
+	u32_t spins = z_spin_acquire(l);
+
+#ifdef CONFIG_SPINLOCK_STATS
+	/* Updated with the lock held */
+	l->acquired++;
+	if (spins != 0U) {
+		l->contended++;
+		l->spins += spins;
 	}
+#else
+	ARG_UNUSED(spins);
+#endif
 #endif
 
 #ifdef CONFIG_SPIN_VALIDATE
@@ -133,14 +206,7 @@ static ALWAYS_INLINE void k_spin_unlock(struct k_spinlock *l,
 #endif
 
 #ifdef CONFIG_SMP
-	/* Strictly we don't need atomic_clear() here (which is an
-	 * exchange operation that returns the old value).  We are always
-	 * setting a zero and (because we hold the lock) know the existing
-	 * state won't change due to a race.  But some architectures need
-	 * a memory barrier when used like this, and we don't have a
-	 * Zephyr framework for that.
-	 */
-	atomic_clear(&l->locked);
+	z_spin_drop(l);
 #endif
 	arch_irq_unlock(key.key);
 }
@@ -155,7 +221,7 @@ static ALWAYS_INLINE void k_spin_release(struct k_spinlock *l)
 	__ASSERT(z_spin_unlock_valid(l), "Not my spinlock %p", l);
 #endif
 #ifdef CONFIG_SMP
-	atomic_clear(&l->locked);
+	z_spin_drop(l);
 #endif
 }
 
@@ -44,9 +44,12 @@ __syscall size_t zephyr_fwrite(const void *_MLIBC_RESTRICT ptr, size_t size,
 extern struct k_mem_partition z_malloc_partition;
 #endif
 
-#if defined(CONFIG_NEWLIB_LIBC) || defined(CONFIG_STACK_CANARIES)
-/* Minimal libc has no globals. We do put the stack canary global in the
- * libc partition since it is not worth placing in a partition of its own.
+#if defined(CONFIG_NEWLIB_LIBC) || defined(CONFIG_STACK_CANARIES) || \
+	(defined(CONFIG_THREAD_LOCAL_STORAGE) && defined(CONFIG_CPU_CORTEX_M))
+/* Minimal libc has no globals. We do put the stack canary global, and
+ * the thread pointer of Cortex-M CPUs which have no register for it, in
+ * the libc partition since they are not worth placing in a partition
+ * of their own.
  */
 #define Z_LIBC_PARTITION_EXISTS 1
 
@@ -12,6 +12,7 @@
 #include <stddef.h>
 #include <stdarg.h>
 #include <inttypes.h>
+#include <sys/util.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -68,6 +69,75 @@ extern __printf_like(3, 0) int vsnprintk(char *str, size_t size,
 extern __printf_like(3, 0) void z_vprintk(int (*out)(int f, void *c), void *ctx,
 					 const char *fmt, va_list ap);
 
+#ifdef CONFIG_PRINTK_DEFERRED
+
+/** @brief Maximum size of a deferred printk() message record */
+#define Z_PRINTK_DEFERRED_MAX_SIZE 64
+
+/* The format pointer is stored first, then each argument with the type
+ * it is promoted to when passed through "...", which is what printk()
+ * reads back from the format.
+ */
+#define Z_PRINTK_DEFERRED_ARG(idx, arg) \
+	__typeof__(1 ? (arg) : (arg)) UTIL_CAT(z_arg, idx);
+
+/**
+ * @brief Print a kernel debugging message, formatted later.
+ *
+ * Takes the same arguments as printk(), but only stores the format
+ * string pointer and the argument values in a buffer. Formatting and
+ * output happen later, from a low priority thread or when
+ * printk_deferred_process() is called. The size of the stored record is
+ * computed at build time from the types of the arguments, so the cost
+ * of the call does not depend on the format.
+ *
+ * Since only pointers are stored, the format string and the strings
+ * printed with \%s must stay valid until the message is output: string
+ * literals are fine, buffers on the stack are not. Messages that do not
+ * fit in the buffer are dropped. Calls from user mode are formatted
+ * immediately.
+ *
+ * May be called from any context, including ISRs.
+ *
+ * @param fmt Format string.
+ * @param ... Optional list of format arguments.
+ */
+#define printk_deferred(fmt, ...) do {					\
+	if (false) {							\
+		printk(fmt, ##__VA_ARGS__);				\
+	}								\
+	struct __packed __aligned(sizeof(u32_t)) {			\
+		FOR_EACH_IDX(Z_PRINTK_DEFERRED_ARG, fmt, ##__VA_ARGS__)	\
+	} z_pkg = { fmt, ##__VA_ARGS__ };				\
+	BUILD_ASSERT(sizeof(z_pkg) <= Z_PRINTK_DEFERRED_MAX_SIZE,	\
+		     "Too many printk_deferred() arguments");		\
+	z_printk_deferred(&z_pkg, sizeof(z_pkg));			\
+} while (false)
+
+/**
+ * @brief Output a deferred printk() message.
+ *
+ * Formats and outputs the oldest message stored by printk_deferred().
+ * Only needed when CONFIG_PRINTK_DEFERRED_THREAD is disabled, or to flush
+ * messages before the thread gets to run, e.g. before a reset.
+ *
+ * @return true if a message was output, false if none was pending.
+ */
+bool printk_deferred_process(void);
+
+void z_printk_deferred(const void *pkg, size_t size);
+
+#else
+
+#define printk_deferred(fmt, ...) printk(fmt, ##__VA_ARGS__)
+
+static inline bool printk_deferred_process(void)
+{
+	return false;
+}
+
+#endif /* CONFIG_PRINTK_DEFERRED */
+
 #ifdef __cplusplus
 }
 #endif
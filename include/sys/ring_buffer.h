@@ -23,6 +23,12 @@ extern "C" {
 
 /**
  * @brief A structure to represent a ring buffer
+ *
+ * A ring buffer has no lock of its own: one producer and one consumer may
+ * access it concurrently, from threads, ISRs or different CPUs, but
+ * multiple producers or multiple consumers must be serialized. See
+ * struct ring_buf_mpsc for a byte mode ring buffer which does this for
+ * its producers.
  */
 struct ring_buf {
 	u32_t head;	 /**< Index in buf for the head element */
@@ -48,6 +54,21 @@ struct ring_buf {
 	u32_t mask;   /**< Modulo mask if size is a power of 2 */
 };
 
+/**
+ * @brief A byte mode ring buffer with multiple producers
+ *
+ * Producers are serialized by a spinlock, held with interrupts locked
+ * from ring_buf_mpsc_put_claim() to ring_buf_mpsc_put_finish(), so
+ * threads and ISRs on any CPU can write to it. The single consumer uses
+ * the regular ring_buf_get_claim(), ring_buf_get_finish() and
+ * ring_buf_get() on the @a rb member, and never takes the lock.
+ */
+struct ring_buf_mpsc {
+	struct ring_buf rb;	/**< Underlying byte mode ring buffer */
+	struct k_spinlock lock;
+	k_spinlock_key_t key;
+};
+
 /**
  * @defgroup ring_buffer_apis Ring Buffer APIs
  * @ingroup kernel_apis
@@ -127,6 +148,28 @@ struct ring_buf {
 		.buf = { .buf8 = _ring_buffer_data_##name} \
 	}
 
+/**
+ * @brief Statically define and initialize a multi-producer ring buffer.
+ *
+ * This macro establishes a byte mode ring buffer of an arbitrary size,
+ * which can be written to by multiple producers at the same time.
+ *
+ * The ring buffer can be accessed outside the module where it is defined
+ * using:
+ *
+ * @code extern struct ring_buf_mpsc <name>; @endcode
+ *
+ * @param name  Name of the ring buffer.
+ * @param size8 Size of ring buffer (in bytes).
+ */
+#define RING_BUF_MPSC_DECLARE(name, size8) \
+	static u8_t _ring_buffer_data_##name[size8]; \
+	struct ring_buf_mpsc name = { \
+		.rb = { \
+			.size = size8, \
+			.buf = { .buf8 = _ring_buffer_data_##name} \
+		} \
+	}
 
 /**
  * @brief Initialize a ring buffer.
@@ -156,6 +199,24 @@ static inline void ring_buf_init(struct ring_buf *buf, u32_t size, void *data)
 	}
 }
 
+/**
+ * @brief Initialize a multi-producer ring buffer.
+ *
+ * This routine initializes a multi-producer ring buffer, prior to its
+ * first use. It is only used for ring buffers not defined using
+ * RING_BUF_MPSC_DECLARE.
+ *
+ * @param mbuf Address of ring buffer.
+ * @param size Ring buffer size (in bytes).
+ * @param data Ring buffer data area (u8_t data[size]).
+ */
+static inline void ring_buf_mpsc_init(struct ring_buf_mpsc *mbuf, u32_t size,
+				      void *data)
+{
+	memset(mbuf, 0, sizeof(struct ring_buf_mpsc));
+	ring_buf_init(&mbuf->rb, size, data);
+}
+
 /** @brief Determine free space based on ring buffer parameters.
  *
  * @note Function for internal use.
@@ -234,9 +295,10 @@ static inline u32_t ring_buf_capacity_get(struct ring_buf *buf)
  * coupled with a 16-bit type identifier and an 8-bit integer value.
  *
  * @warning
- * Use cases involving multiple writers to the ring buffer must prevent
- * concurrent write operations, either by preventing all writers from
- * being preempted or by using a mutex to govern writes to the ring buffer.
+ * A single writer may run concurrently with a single reader. Use cases
+ * involving multiple writers to the ring buffer must prevent concurrent
+ * write operations, either by preventing all writers from being preempted
+ * or by using a mutex to govern writes to the ring buffer.
  *
  * @param buf Address of ring buffer.
  * @param type Data item's type identifier (application specific).
@@ -258,9 +320,10 @@ int ring_buf_item_put(struct ring_buf *buf, u16_t type, u8_t value,
  * coupled with a 16-bit type identifier and an 8-bit integer value.
  *
  * @warning
- * Use cases involving multiple reads of the ring buffer must prevent
- * concurrent read operations, either by preventing all readers from
- * being preempted or by using a mutex to govern reads to the ring buffer.
+ * A single reader may run concurrently with a single writer. Use cases
+ * involving multiple reads of the ring buffer must prevent concurrent
+ * read operations, either by preventing all readers from being preempted
+ * or by using a mutex to govern reads to the ring buffer.
  *
  * @param buf Address of ring buffer.
  * @param type Area to store the data item's type identifier.
@@ -285,9 +348,10 @@ int ring_buf_item_get(struct ring_buf *buf, u16_t *type, u8_t *value,
  * number of bytes written can be confirmed (see @ref ring_buf_put_finish).
  *
  * @warning
- * Use cases involving multiple writers to the ring buffer must prevent
- * concurrent write operations, either by preventing all writers from
- * being preempted or by using a mutex to govern writes to the ring buffer.
+ * A single writer may run concurrently with a single reader. Use cases
+ * involving multiple writers to the ring buffer must prevent concurrent
+ * write operations, either by preventing all writers from being preempted
+ * or by using a mutex to govern writes to the ring buffer.
  *
  * @warning
  * Ring buffer instance should not mix byte access and item access
@@ -307,9 +371,10 @@ u32_t ring_buf_put_claim(struct ring_buf *buf, u8_t **data, u32_t size);
  * @brief Indicate number of bytes written to allocated buffers.
  *
  * @warning
- * Use cases involving multiple writers to the ring buffer must prevent
- * concurrent write operations, either by preventing all writers from
- * being preempted or by using a mutex to govern writes to the ring buffer.
+ * A single writer may run concurrently with a single reader. Use cases
+ * involving multiple writers to the ring buffer must prevent concurrent
+ * write operations, either by preventing all writers from being preempted
+ * or by using a mutex to govern writes to the ring buffer.
  *
  * @warning
  * Ring buffer instance should not mix byte access and item access
@@ -329,9 +394,10 @@ int ring_buf_put_finish(struct ring_buf *buf, u32_t size);
  * This routine writes data to a ring buffer @a buf.
  *
  * @warning
- * Use cases involving multiple writers to the ring buffer must prevent
- * concurrent write operations, either by preventing all writers from
- * being preempted or by using a mutex to govern writes to the ring buffer.
+ * A single writer may run concurrently with a single reader. Use cases
+ * involving multiple writers to the ring buffer must prevent concurrent
+ * write operations, either by preventing all writers from being preempted
+ * or by using a mutex to govern writes to the ring buffer.
  *
  * @warning
  * Ring buffer instance should not mix byte access and item access
@@ -353,9 +419,10 @@ u32_t ring_buf_put(struct ring_buf *buf, const u8_t *data, u32_t size);
  * using @ref ring_buf_get_finish.
  *
  * @warning
- * Use cases involving multiple reads of the ring buffer must prevent
- * concurrent read operations, either by preventing all readers from
- * being preempted or by using a mutex to govern reads to the ring buffer.
+ * A single reader may run concurrently with a single writer. Use cases
+ * involving multiple reads of the ring buffer must prevent concurrent
+ * read operations, either by preventing all readers from being preempted
+ * or by using a mutex to govern reads to the ring buffer.
  *
  * @warning
  * Ring buffer instance should not mix byte access and item access
@@ -375,9 +442,10 @@ u32_t ring_buf_get_claim(struct ring_buf *buf, u8_t **data, u32_t size);
  * @brief Indicate number of bytes read from claimed buffer.
  *
  * @warning
- * Use cases involving multiple reads of the ring buffer must prevent
- * concurrent read operations, either by preventing all readers from
- * being preempted or by using a mutex to govern reads to the ring buffer.
+ * A single reader may run concurrently with a single writer. Use cases
+ * involving multiple reads of the ring buffer must prevent concurrent
+ * read operations, either by preventing all readers from being preempted
+ * or by using a mutex to govern reads to the ring buffer.
  *
  * @warning
  * Ring buffer instance should not mix byte access and  item mode
@@ -397,9 +465,10 @@ int ring_buf_get_finish(struct ring_buf *buf, u32_t size);
  * This routine reads data from a ring buffer @a buf.
  *
  * @warning
- * Use cases involving multiple reads of the ring buffer must prevent
- * concurrent read operations, either by preventing all readers from
- * being preempted or by using a mutex to govern reads to the ring buffer.
+ * A single reader may run concurrently with a single writer. Use cases
+ * involving multiple reads of the ring buffer must prevent concurrent
+ * read operations, either by preventing all readers from being preempted
+ * or by using a mutex to govern reads to the ring buffer.
  *
  * @warning
  * Ring buffer instance should not mix byte access and  item mode
@@ -413,6 +482,57 @@ int ring_buf_get_finish(struct ring_buf *buf, u32_t size);
  */
 u32_t ring_buf_get(struct ring_buf *buf, u8_t *data, u32_t size);
 
+/**
+ * @brief Allocate buffer for writing data to a multi-producer ring buffer.
+ *
+ * Works as @ref ring_buf_put_claim, but also acquires the producer lock
+ * of the ring buffer, which is held until @ref ring_buf_mpsc_put_finish
+ * is called. It must therefore be called only once before each call to
+ * @ref ring_buf_mpsc_put_finish, and the claimed area should be filled
+ * promptly. When less space than requested is granted because the buffer
+ * wraps, the rest can be claimed after finishing the first part.
+ *
+ * @param[in]  mbuf Address of ring buffer.
+ * @param[out] data Pointer to the address. It is set to a location within
+ *		    ring buffer.
+ * @param[in]  size Requested allocation size (in bytes).
+ *
+ * @return Size of allocated buffer which can be smaller than requested if
+ *	   there is not enough free space or buffer wraps.
+ */
+u32_t ring_buf_mpsc_put_claim(struct ring_buf_mpsc *mbuf, u8_t **data,
+			      u32_t size);
+
+/**
+ * @brief Indicate number of bytes written to a multi-producer ring buffer.
+ *
+ * Works as @ref ring_buf_put_finish, and releases the producer lock
+ * acquired by @ref ring_buf_mpsc_put_claim. On error, the claimed area
+ * is given back to the ring buffer.
+ *
+ * @param  mbuf Address of ring buffer.
+ * @param  size Number of valid bytes in the allocated buffer.
+ *
+ * @retval 0 Successful operation.
+ * @retval -EINVAL Provided @a size exceeds free space in the ring buffer.
+ */
+int ring_buf_mpsc_put_finish(struct ring_buf_mpsc *mbuf, u32_t size);
+
+/**
+ * @brief Write (copy) data to a multi-producer ring buffer.
+ *
+ * This routine writes data to a ring buffer @a mbuf. It may be called
+ * by any number of threads and ISRs at the same time.
+ *
+ * @param mbuf Address of ring buffer.
+ * @param data Address of data.
+ * @param size Data size (in bytes).
+ *
+ * @retval Number of bytes written.
+ */
+u32_t ring_buf_mpsc_put(struct ring_buf_mpsc *mbuf, const u8_t *data,
+			u32_t size);
+
 /**
  * @}
  */
@@ -38,7 +38,10 @@
  * that has a compile-time-configurable upper bound, setting this to
  * extreme values results in an effectively linear search of the
  * list), objectively fast (~hundred instructions) and and amenable to
- * locked operation.
+ * locked operation.  Optionally (CONFIG_SYS_HEAP_SIZE_CLASSES), the
+ * smallest sizes are served from exact-fit caches of recently freed
+ * chunks, which avoids the bucket search, splitting and merging
+ * entirely for workloads dominated by small objects.
  */
 
 /* Note: the init_mem/bytes fields are for the static initializer to
@@ -54,6 +57,29 @@ struct sys_heap {
 	size_t init_bytes;
 };
 
+/** @brief Runtime statistics of a sys_heap
+ *
+ * Byte counts are in units of the heap's 8 byte chunks and include
+ * the per-allocation chunk headers.
+ */
+struct sys_heap_runtime_stats {
+	/** Bytes available for allocation */
+	size_t free_bytes;
+	/** Bytes currently allocated */
+	size_t allocated_bytes;
+	/** Highest value allocated_bytes has reached */
+	size_t max_allocated_bytes;
+	/** Size of the largest contiguous free chunk */
+	size_t largest_free_bytes;
+	/** Number of free chunks the free bytes are split into */
+	size_t free_chunks;
+	/** Percentage of free bytes outside the largest free chunk: 0
+	 *  means a single free block, values near 100 mean free memory
+	 *  is scattered in small fragments
+	 */
+	unsigned int fragmentation;
+};
+
 struct z_heap_stress_result {
 	u32_t total_allocs;
 	u32_t successful_allocs;
@@ -103,6 +129,70 @@ void *sys_heap_alloc(struct sys_heap *h, size_t bytes);
  */
 void sys_heap_free(struct sys_heap *h, void *mem);
 
+/** @brief Allocate aligned memory from a sys_heap
+ *
+ * Behaves in all ways like sys_heap_alloc(), except that the returned
+ * memory (if available) will have a starting address in memory which
+ * is a multiple of the specified power-of-two alignment value in
+ * bytes.  The resulting memory can be returned to the heap using
+ * sys_heap_free().
+ *
+ * @param h Heap from which to allocate
+ * @param align Alignment in bytes, must be a power of two
+ * @param bytes Number of bytes requested
+ * @return Pointer to memory the caller can now use
+ */
+void *sys_heap_aligned_alloc(struct sys_heap *h, size_t align, size_t bytes);
+
+/** @brief Expand the size of an existing allocation
+ *
+ * Returns a pointer to a new memory region with the same contents,
+ * but a different allocated size.  If the new allocation can be
+ * expanded in place (because the memory after it is free), the
+ * pointer returned will be identical; shrinking is always done in
+ * place.  Otherwise the data is copied to a new block and the old one
+ * freed.  As with realloc(), a NULL @a ptr allocates and a zero @a
+ * bytes frees.  If no memory is available NULL is returned and the
+ * original block is left untouched.
+ *
+ * @note The alignment of a block obtained from
+ * sys_heap_aligned_alloc() is only preserved when it is resized in
+ * place.
+ *
+ * @param h Heap from which to allocate
+ * @param ptr Original pointer returned from a previous allocation
+ * @param bytes Number of bytes requested for the new block
+ * @return Pointer to memory the caller can now use, or NULL
+ */
+void *sys_heap_realloc(struct sys_heap *h, void *ptr, size_t bytes);
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+/** @brief Get runtime statistics of a sys_heap
+ *
+ * The allocated byte counts are maintained incrementally by the
+ * allocation and free calls.  The largest free chunk is found by
+ * walking only the highest non-empty free list bucket.
+ *
+ * @note The sys_heap implementation is not internally synchronized.
+ * No two sys_heap functions should operate on the same heap at the
+ * same time.  All locking must be provided by the user.
+ *
+ * @param h Heap to inspect
+ * @param stats Structure to fill in
+ */
+void sys_heap_runtime_stats_get(struct sys_heap *h,
+				struct sys_heap_runtime_stats *stats);
+
+/** @brief Reset the high water mark of a sys_heap
+ *
+ * Sets max_allocated_bytes to the number of bytes currently
+ * allocated.
+ *
+ * @param h Heap to reset
+ */
+void sys_heap_runtime_stats_reset_max(struct sys_heap *h);
+#endif
+
 /** @brief Validate heap integrity
  *
  * Validates the internal integrity of a sys_heap.  Intended for unit
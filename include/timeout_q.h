@@ -24,7 +24,17 @@ extern "C" {
 
 static inline void z_init_timeout(struct _timeout *t)
 {
+#ifdef CONFIG_TIMEOUT_QUEUE_SCALABLE
+	t->expiry = 0U;
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	t->cpu = 0U;
+#endif
+#else
 	sys_dnode_init(&t->node);
+#endif
+#ifdef CONFIG_TIMEOUT_SLACK
+	t->slack = 0U;
+#endif
 }
 
 void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
@@ -34,7 +44,11 @@ int z_abort_timeout(struct _timeout *to);
 
 static inline bool z_is_inactive_timeout(struct _timeout *t)
 {
+#ifdef CONFIG_TIMEOUT_QUEUE_SCALABLE
+	return t->expiry == 0U;
+#else
 	return !sys_dnode_is_linked(&t->node);
+#endif
 }
 
 static inline void z_init_thread_timeout(struct _thread_base *thread_base)
@@ -60,6 +74,22 @@ void z_set_timeout_expiry(s32_t ticks, bool idle);
 
 k_ticks_t z_timeout_remaining(struct _timeout *timeout);
 
+#ifdef CONFIG_TIMEOUT_SLACK
+/* Sets how far the expiry of a timeout may be deferred so that it
+ * can be handled together with other timeouts
+ */
+void z_timeout_slack_set(struct _timeout *to, k_timeout_t slack);
+#else
+#define z_timeout_slack_set(to, slack) do {} while (false)
+#endif
+
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+/* Runs the current CPU's expired timeouts, called from the scheduler
+ * IPI handler
+ */
+void z_timeout_ipi(void);
+#endif
+
 #else
 
 /* Stubs when !CONFIG_SYS_CLOCK_EXISTS */
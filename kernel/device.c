@@ -29,6 +29,281 @@ extern u32_t __device_busy_end[];
 #define DEVICE_BUSY_SIZE (__device_busy_end - __device_busy_start)
 #endif
 
+static void init_entry_run(const struct init_entry *entry)
+{
+	struct device *dev = entry->dev;
+	int retval;
+
+	if (dev != NULL) {
+		z_object_init(dev);
+	}
+
+	retval = entry->init(dev);
+	if (retval != 0) {
+		if (dev) {
+			/* Initialization failed. Clear the API struct
+			 * so that device_get_binding() will not succeed
+			 * for it.
+			 */
+			dev->driver_api = NULL;
+		}
+	}
+}
+
+#ifdef CONFIG_INIT_PARALLEL
+
+enum {
+	INIT_PENDING,
+	INIT_RUNNING,
+	INIT_DONE,
+};
+
+/* The run of consecutive init entries with a parallel descriptor
+ * being initialized, and the threads helping the main one with it
+ */
+static struct {
+	const struct init_entry *start;
+	const struct init_entry *end;
+	struct k_spinlock lock;
+	/* given once per waiting thread when an entry completes */
+	struct k_sem progress;
+	int waiting;
+} batch;
+
+static K_THREAD_STACK_ARRAY_DEFINE(init_stacks, CONFIG_INIT_PARALLEL_THREADS,
+				   CONFIG_INIT_PARALLEL_STACK_SIZE);
+static struct k_thread init_threads[CONFIG_INIT_PARALLEL_THREADS];
+
+static bool device_name_is(struct device *dev, const char *name)
+{
+	return dev->name == name || strcmp(dev->name, name) == 0;
+}
+
+static void init_parallel_resolve(void)
+{
+	Z_STRUCT_SECTION_FOREACH(init_parallel, p) {
+		for (struct device *dev = __device_start;
+		     dev != __device_end; dev++) {
+			if (device_name_is(dev, p->dev_name)) {
+				p->dev = dev;
+				break;
+			}
+		}
+	}
+}
+
+static struct init_parallel *parallel_of(const struct init_entry *entry)
+{
+	if (entry->dev == NULL) {
+		return NULL;
+	}
+
+	Z_STRUCT_SECTION_FOREACH(init_parallel, p) {
+		if (p->dev == entry->dev) {
+			return p;
+		}
+	}
+
+	return NULL;
+}
+
+/* Whether the dependencies of an entry that are earlier in the batch
+ * are all initialized.  Later ones would contradict the init
+ * priorities and are ignored.  Must be called with the batch lock.
+ */
+static bool deps_done(const struct init_entry *entry, struct init_parallel *p)
+{
+	for (int i = 0; i < p->num_deps; i++) {
+		for (const struct init_entry *e = batch.start; e < entry; e++) {
+			if (device_name_is(e->dev, p->deps[i]) &&
+			    parallel_of(e)->state != INIT_DONE) {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+/* Claims the first pending entry that can be initialized, if any, and
+ * tells whether any entry is left pending.  Must be called with the
+ * batch lock.
+ */
+static const struct init_entry *claim_entry(bool *pending)
+{
+	*pending = false;
+
+	for (const struct init_entry *e = batch.start; e < batch.end; e++) {
+		struct init_parallel *p = parallel_of(e);
+
+		if (p->state != INIT_PENDING) {
+			continue;
+		}
+
+		*pending = true;
+		if (deps_done(e, p)) {
+			p->state = INIT_RUNNING;
+			return e;
+		}
+	}
+
+	return NULL;
+}
+
+static void init_worker(void *p1, void *p2, void *p3)
+{
+	k_spinlock_key_t key = k_spin_lock(&batch.lock);
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (;;) {
+		const struct init_entry *entry;
+		bool pending;
+		int waiting;
+
+		entry = claim_entry(&pending);
+		if (entry == NULL && !pending) {
+			break;
+		}
+
+		if (entry == NULL) {
+			/* Everything left waits on entries being run */
+			batch.waiting++;
+			k_spin_unlock(&batch.lock, key);
+			k_sem_take(&batch.progress, K_FOREVER);
+			key = k_spin_lock(&batch.lock);
+			continue;
+		}
+
+		k_spin_unlock(&batch.lock, key);
+		init_entry_run(entry);
+		key = k_spin_lock(&batch.lock);
+
+		parallel_of(entry)->state = INIT_DONE;
+		waiting = batch.waiting;
+		batch.waiting = 0;
+
+		k_spin_unlock(&batch.lock, key);
+		while (waiting-- > 0) {
+			k_sem_give(&batch.progress);
+		}
+		key = k_spin_lock(&batch.lock);
+	}
+
+	k_spin_unlock(&batch.lock, key);
+}
+
+/* Initializes the entries in [start, end), which all have a parallel
+ * descriptor, on the calling thread and up to
+ * CONFIG_INIT_PARALLEL_THREADS more, and returns once all are done
+ */
+static void init_batch_run(const struct init_entry *start,
+			   const struct init_entry *end)
+{
+	int threads = MIN(end - start - 1, CONFIG_INIT_PARALLEL_THREADS);
+	int prio = k_thread_priority_get(k_current_get());
+
+	batch.start = start;
+	batch.end = end;
+	batch.waiting = 0;
+	k_sem_init(&batch.progress, 0, CONFIG_INIT_PARALLEL_THREADS + 1);
+
+	for (const struct init_entry *e = start; e < end; e++) {
+		parallel_of(e)->state = INIT_PENDING;
+	}
+
+	for (int i = 0; i < threads; i++) {
+		k_thread_create(&init_threads[i], init_stacks[i],
+				K_THREAD_STACK_SIZEOF(init_stacks[i]),
+				init_worker, NULL, NULL, NULL,
+				prio, 0, K_NO_WAIT);
+		k_thread_name_set(&init_threads[i], "init");
+	}
+
+	init_worker(NULL, NULL, NULL);
+
+	for (int i = 0; i < threads; i++) {
+		k_thread_join(&init_threads[i], K_FOREVER);
+	}
+}
+
+#endif /* CONFIG_INIT_PARALLEL */
+
+#ifdef CONFIG_DEVICE_NAME_HASH
+
+#define DEVICE_HASH_SIZE BIT(CONFIG_DEVICE_NAME_HASH_BITS)
+
+/* Open addressing table, with linear probing, of 1 + the index of each
+ * device by hash of its name.  0 marks an empty slot.
+ */
+static u16_t device_hash[DEVICE_HASH_SIZE];
+static bool device_hash_ready;
+/* Some devices did not fit in the table */
+static bool device_hash_overflow;
+
+static u32_t device_name_hash(const char *name)
+{
+	/* FNV-1a */
+	u32_t hash = 2166136261U;
+
+	while (*name != '\0') {
+		hash = (hash ^ (u8_t)*name++) * 16777619U;
+	}
+
+	return hash;
+}
+
+static void device_hash_build(void)
+{
+	for (struct device *dev = __device_start; dev != __device_end; dev++) {
+		u32_t slot = device_name_hash(dev->name);
+		u32_t probe;
+
+		for (probe = 0; probe < DEVICE_HASH_SIZE; probe++) {
+			u16_t *entry = &device_hash[(slot + probe) &
+						    (DEVICE_HASH_SIZE - 1)];
+
+			if (*entry == 0) {
+				*entry = dev - __device_start + 1;
+				break;
+			}
+		}
+
+		if (probe == DEVICE_HASH_SIZE) {
+			device_hash_overflow = true;
+		}
+	}
+
+	device_hash_ready = true;
+}
+
+static struct device *device_hash_find(const char *name)
+{
+	u32_t slot = device_name_hash(name);
+
+	for (u32_t probe = 0; probe < DEVICE_HASH_SIZE; probe++) {
+		u16_t entry = device_hash[(slot + probe) &
+					  (DEVICE_HASH_SIZE - 1)];
+		struct device *dev;
+
+		if (entry == 0) {
+			break;
+		}
+
+		dev = &__device_start[entry - 1];
+		if ((dev->driver_api != NULL) &&
+		    ((dev->name == name) || (strcmp(name, dev->name) == 0))) {
+			return dev;
+		}
+	}
+
+	return NULL;
+}
+
+#endif /* CONFIG_DEVICE_NAME_HASH */
+
 /**
  * @brief Execute all the init entry initialization functions at a given level
  *
@@ -38,6 +313,10 @@ extern u32_t __device_busy_end[];
  * they need to be invoked, with symbols indicating where one level leaves
  * off and the next one begins.
  *
+ * With CONFIG_INIT_PARALLEL, runs of consecutive devices declared with
+ * INIT_PARALLEL() are initialized concurrently from the POST_KERNEL
+ * level on, see init_batch_run().
+ *
  * @param level init level to run.
  */
 void z_sys_init_run_level(s32_t level)
@@ -54,32 +333,61 @@ void z_sys_init_run_level(s32_t level)
 		__init_end,
 	};
 	const struct init_entry *entry;
+#ifdef CONFIG_INIT_PARALLEL
+	const struct init_entry *batch_start = NULL;
+#endif
 
-	for (entry = levels[level]; entry < levels[level+1]; entry++) {
-		struct device *dev = entry->dev;
-		int retval;
+#ifdef CONFIG_DEVICE_NAME_HASH
+	if (level == _SYS_INIT_LEVEL_PRE_KERNEL_1) {
+		device_hash_build();
+	}
+#endif
 
-		if (dev != NULL) {
-			z_object_init(dev);
-		}
+#ifdef CONFIG_INIT_PARALLEL
+	if (level == _SYS_INIT_LEVEL_POST_KERNEL) {
+		init_parallel_resolve();
+	}
+#endif
 
-		retval = entry->init(dev);
-		if (retval != 0) {
-			if (dev) {
-				/* Initialization failed. Clear the API struct
-				 * so that device_get_binding() will not succeed
-				 * for it.
-				 */
-				dev->driver_api = NULL;
+	for (entry = levels[level]; entry < levels[level+1]; entry++) {
+#ifdef CONFIG_INIT_PARALLEL
+		if (level >= _SYS_INIT_LEVEL_POST_KERNEL &&
+		    parallel_of(entry) != NULL) {
+			if (batch_start == NULL) {
+				batch_start = entry;
 			}
+			continue;
+		}
+
+		if (batch_start != NULL) {
+			init_batch_run(batch_start, entry);
+			batch_start = NULL;
 		}
+#endif
+		init_entry_run(entry);
 	}
+
+#ifdef CONFIG_INIT_PARALLEL
+	if (batch_start != NULL) {
+		init_batch_run(batch_start, entry);
+	}
+#endif
 }
 
 struct device *z_impl_device_get_binding(const char *name)
 {
 	struct device *dev;
 
+#ifdef CONFIG_DEVICE_NAME_HASH
+	/* The table is built when the first init level is run */
+	if (device_hash_ready) {
+		dev = device_hash_find(name);
+		if ((dev != NULL) || !device_hash_overflow) {
+			return dev;
+		}
+	}
+#endif
+
 	/* Split the search into two loops: in the common scenario, where
 	 * device names are stored in ROM (and are referenced by the user
 	 * with CONFIG_* macros), only cheap pointer comparisons will be
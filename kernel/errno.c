@@ -23,7 +23,9 @@
 const int _k_neg_eagain = -EAGAIN;
 
 #ifdef CONFIG_ERRNO
-#ifdef CONFIG_USERSPACE
+#ifdef CONFIG_ERRNO_IN_TLS
+__thread int z_errno_var;
+#elif defined(CONFIG_USERSPACE)
 int *z_impl_z_errno(void)
 {
 	/* Initialized to the lowest address in the stack so the thread can
@@ -43,5 +45,5 @@ int *z_impl_z_errno(void)
 {
 	return &_current->errno_var;
 }
-#endif /* CONFIG_USERSPACE */
+#endif /* CONFIG_ERRNO_IN_TLS */
 #endif /* CONFIG_ERRNO */
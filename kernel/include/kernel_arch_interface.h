@@ -181,6 +181,23 @@ void arch_switch_to_main_thread(struct k_thread *main_thread,
 int arch_float_disable(struct k_thread *thread);
 #endif /* CONFIG_FPU && CONFIG_FPU_SHARING */
 
+#ifdef CONFIG_THREAD_LOCAL_STORAGE
+/**
+ * @brief Set up the thread local storage area of a new thread
+ *
+ * Copies the initial image of the thread local variables, see
+ * z_tls_copy(), into the area that ends at @a stack_ptr, in the layout
+ * the architecture's compiler expects, along with any control block it
+ * needs. The thread pointer to load on context switches is stored in
+ * @a new_thread's tls member.
+ *
+ * @param new_thread Thread being created
+ * @param stack_ptr Top of the thread's stack buffer
+ * @return Number of bytes used below @a stack_ptr
+ */
+size_t arch_tls_stack_setup(struct k_thread *new_thread, char *stack_ptr);
+#endif /* CONFIG_THREAD_LOCAL_STORAGE */
+
 /** @} */
 
 /**
@@ -141,6 +141,22 @@ extern K_THREAD_STACK_ARRAY_DEFINE(z_interrupt_stacks, CONFIG_MP_NUM_CPUS,
 extern u8_t *z_priv_stack_find(k_thread_stack_t *stack);
 #endif
 
+#ifdef CONFIG_THREAD_RUNTIME_STATS
+/* Charges the time since the previous switch on this CPU to the thread
+ * switched out, and starts timing _current
+ */
+void z_thread_mark_switched_in(void);
+
+/* Records that a thread became ready, to time its scheduling latency */
+static inline void z_thread_mark_ready(struct k_thread *thread)
+{
+	u32_t now = k_cycle_get_32();
+
+	/* 0 means "not waiting" */
+	thread->ready_stamp = (now != 0U) ? now : 1U;
+}
+#endif
+
 #ifdef __cplusplus
 }
 #endif
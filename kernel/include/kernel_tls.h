@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Kernel Thread Local Storage APIs.
+ *
+ * Kernel APIs related to thread local storage.
+ */
+
+#ifndef ZEPHYR_KERNEL_INCLUDE_KERNEL_TLS_H_
+#define ZEPHYR_KERNEL_INCLUDE_KERNEL_TLS_H_
+
+#include <linker/linker-defs.h>
+#include <string.h>
+
+/**
+ * @brief Return the size of the thread local variables
+ *
+ * This is the size of the initialized variables, followed by the
+ * zero-initialized ones, without any control block the architecture
+ * may need around them.
+ */
+static inline size_t z_tls_data_size(void)
+{
+	return (size_t)__tls_size;
+}
+
+/**
+ * @brief Return the alignment required by the thread local variables
+ */
+static inline size_t z_tls_data_align(void)
+{
+	return (size_t)__tls_align;
+}
+
+/**
+ * @brief Copy the initial values of the thread local variables
+ *
+ * Fills z_tls_data_size() bytes at @a dest with the initialized
+ * variables, and zeroes the rest.
+ *
+ * @param dest Start of the thread's thread local variables
+ */
+static inline void z_tls_copy(char *dest)
+{
+	size_t tdata_size = (size_t)__tdata_size;
+
+	(void)memcpy(dest, __tdata_start, tdata_size);
+	(void)memset(dest + tdata_size, 0, z_tls_data_size() - tdata_size);
+}
+
+#endif /* ZEPHYR_KERNEL_INCLUDE_KERNEL_TLS_H_ */
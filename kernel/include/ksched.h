@@ -58,7 +58,7 @@ struct k_thread *z_find_first_thread_to_unpend(_wait_q_t *wait_q,
 					      struct k_thread *from);
 void idle(void *a, void *b, void *c);
 void z_time_slice(int ticks);
-void z_reset_time_slice(void);
+void z_reset_time_slice(struct k_thread *curr);
 void z_sched_abort(struct k_thread *thread);
 void z_sched_ipi(void);
 void z_sched_start(struct k_thread *thread);
@@ -290,7 +290,7 @@ static ALWAYS_INLINE void z_sched_unlock_no_reschedule(void)
 
 static ALWAYS_INLINE bool z_is_thread_timeout_expired(struct k_thread *thread)
 {
-#ifdef CONFIG_SYS_CLOCK_EXISTS
+#if defined(CONFIG_SYS_CLOCK_EXISTS) && !defined(CONFIG_TIMEOUT_QUEUE_SCALABLE)
 	return thread->base.timeout.dticks == _EXPIRED;
 #else
 	return 0;
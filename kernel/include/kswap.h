@@ -99,7 +99,7 @@ static ALWAYS_INLINE unsigned int do_swap(unsigned int key,
 	if (new_thread != old_thread) {
 		sys_trace_thread_switched_out();
 #ifdef CONFIG_TIMESLICING
-		z_reset_time_slice();
+		z_reset_time_slice(new_thread);
 #endif
 
 		old_thread->swap_retval = -EAGAIN;
@@ -114,6 +114,9 @@ static ALWAYS_INLINE unsigned int do_swap(unsigned int key,
 		}
 #endif
 		_current_cpu->current = new_thread;
+#ifdef CONFIG_THREAD_RUNTIME_STATS
+		z_thread_mark_switched_in();
+#endif
 		wait_for_switch(new_thread);
 		arch_switch(new_thread->switch_handle,
 			     &old_thread->switch_handle);
@@ -198,6 +201,12 @@ static inline void z_dummy_thread_init(struct k_thread *dummy_thread)
 	dummy_thread->base.cpu_mask = -1;
 #endif
 	dummy_thread->base.user_options = K_ESSENTIAL;
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	dummy_thread->base.cbs_budget = 0;
+#endif
+#ifdef CONFIG_TIMESLICE_PER_THREAD
+	dummy_thread->base.slice_ticks = 0;
+#endif
 #ifdef CONFIG_THREAD_STACK_INFO
 	dummy_thread->stack_info.start = 0U;
 	dummy_thread->stack_info.size = 0U;
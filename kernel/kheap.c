@@ -26,7 +26,8 @@ static int statics_init(struct device *unused)
 
 SYS_INIT(statics_init, PRE_KERNEL_1, CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
 
-void *k_heap_alloc(struct k_heap *h, size_t bytes, k_timeout_t timeout)
+void *k_heap_aligned_alloc(struct k_heap *h, size_t align, size_t bytes,
+			   k_timeout_t timeout)
 {
 	s64_t now, end = z_timeout_end_calc(timeout);
 	void *ret = NULL;
@@ -35,7 +36,7 @@ void *k_heap_alloc(struct k_heap *h, size_t bytes, k_timeout_t timeout)
 	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
 
 	while (ret == NULL) {
-		ret = sys_heap_alloc(&h->heap, bytes);
+		ret = sys_heap_aligned_alloc(&h->heap, align, bytes);
 
 		now = z_tick_get();
 		if ((ret != NULL) || ((end - now) <= 0)) {
@@ -51,6 +52,11 @@ void *k_heap_alloc(struct k_heap *h, size_t bytes, k_timeout_t timeout)
 	return ret;
 }
 
+void *k_heap_alloc(struct k_heap *h, size_t bytes, k_timeout_t timeout)
+{
+	return k_heap_aligned_alloc(h, sizeof(void *), bytes, timeout);
+}
+
 void k_heap_free(struct k_heap *h, void *mem)
 {
 	k_spinlock_key_t key = k_spin_lock(&h->lock);
@@ -64,6 +70,25 @@ void k_heap_free(struct k_heap *h, void *mem)
 	}
 }
 
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+void k_heap_runtime_stats_get(struct k_heap *h,
+			      struct sys_heap_runtime_stats *stats)
+{
+	k_spinlock_key_t key = k_spin_lock(&h->lock);
+
+	sys_heap_runtime_stats_get(&h->heap, stats);
+	k_spin_unlock(&h->lock, key);
+}
+
+void k_heap_runtime_stats_reset_max(struct k_heap *h)
+{
+	k_spinlock_key_t key = k_spin_lock(&h->lock);
+
+	sys_heap_runtime_stats_reset_max(&h->heap);
+	k_spin_unlock(&h->lock, key);
+}
+#endif
+
 #ifdef CONFIG_MEM_POOL_HEAP_BACKEND
 /* Compatibility layer for legacy k_mem_pool code on top of a k_heap
  * backend.
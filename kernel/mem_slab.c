@@ -14,8 +14,10 @@
 #include <ksched.h>
 #include <init.h>
 #include <sys/check.h>
+#include <string.h>
 
 static struct k_spinlock lock;
+Z_SPINLOCK_STATS_DEFINE(mem_slab, lock);
 
 #ifdef CONFIG_OBJECT_TRACING
 struct k_mem_slab *_trace_list_k_mem_slab;
@@ -88,6 +90,10 @@ int k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 	slab->block_size = block_size;
 	slab->buffer = buffer;
 	slab->num_used = 0U;
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+	(void)memset(slab->magazines, 0, sizeof(slab->magazines));
+	atomic_clear(&slab->waiters);
+#endif
 	rc = create_free_list(slab);
 	if (rc < 0) {
 		goto out;
@@ -101,6 +107,245 @@ out:
 	return rc;
 }
 
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+
+/* Blocks moved between a magazine and the shared free list at a time */
+#define MAGAZINE_BATCH MAX(CONFIG_MEM_SLAB_MAGAZINE_SIZE / 2, 1)
+
+/*
+ * Each CPU caches up to CONFIG_MEM_SLAB_MAGAZINE_SIZE free blocks of a slab,
+ * protected by a lock private to that CPU.  slab->num_used counts every
+ * block that is not on the shared free list, cached ones included.
+ *
+ * A cached block must never be stranded while a thread waits for one.  An
+ * allocator that finds the free list empty raises slab->waiters and then
+ * empties every magazine; a freer pushes into its magazine and then checks
+ * slab->waiters, emptying the magazines itself if it is set.  Either the
+ * allocator sees the freed block or the freer sees the allocator.  The
+ * lock order is the slab lock, then a magazine lock.
+ */
+
+static struct z_mem_slab_magazine *local_magazine(struct k_mem_slab *slab)
+{
+	return &slab->magazines[_current_cpu->id];
+}
+
+/* Hand a free block to the first waiter, or return it to the free list.
+ * Returns true if a thread was readied.  Called with the slab lock held.
+ */
+static bool slab_put(struct k_mem_slab *slab, char *block)
+{
+	struct k_thread *pending_thread = z_unpend_first_thread(&slab->wait_q);
+
+	if (pending_thread != NULL) {
+		z_thread_return_value_set_with_data(pending_thread, 0, block);
+		z_ready_thread(pending_thread);
+		return true;
+	}
+
+	*(char **)block = slab->free_list;
+	slab->free_list = block;
+	slab->num_used--;
+	return false;
+}
+
+/* Move up to @a n blocks from @a mag to waiters or the free list.  Called
+ * with the slab lock held.
+ */
+static bool magazine_drain(struct k_mem_slab *slab,
+			   struct z_mem_slab_magazine *mag, u32_t n)
+{
+	k_spinlock_key_t key = k_spin_lock(&mag->lock);
+	bool readied = false;
+
+	while (n > 0U && mag->count > 0U) {
+		readied |= slab_put(slab, mag->blocks[--mag->count]);
+		n--;
+	}
+
+	k_spin_unlock(&mag->lock, key);
+
+	return readied;
+}
+
+static bool magazine_reclaim(struct k_mem_slab *slab)
+{
+	bool readied = false;
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		readied |= magazine_drain(slab, &slab->magazines[i],
+					  CONFIG_MEM_SLAB_MAGAZINE_SIZE);
+	}
+
+	return readied;
+}
+
+static bool magazine_alloc(struct k_mem_slab *slab, void **mem)
+{
+	unsigned int irq_key = arch_irq_lock();
+	struct z_mem_slab_magazine *mag = local_magazine(slab);
+	k_spinlock_key_t key = k_spin_lock(&mag->lock);
+	bool hit = mag->count > 0U;
+
+	if (hit) {
+		*mem = mag->blocks[--mag->count];
+		mag->alloc_hits++;
+	} else {
+		mag->alloc_misses++;
+	}
+
+	k_spin_unlock(&mag->lock, key);
+	arch_irq_unlock(irq_key);
+
+	return hit;
+}
+
+static bool magazine_free(struct k_mem_slab *slab, void *block)
+{
+	unsigned int irq_key;
+	struct z_mem_slab_magazine *mag;
+	k_spinlock_key_t key;
+	bool hit;
+
+	if (atomic_get(&slab->waiters) != 0) {
+		return false;
+	}
+
+	irq_key = arch_irq_lock();
+	mag = local_magazine(slab);
+	key = k_spin_lock(&mag->lock);
+	hit = mag->count < CONFIG_MEM_SLAB_MAGAZINE_SIZE;
+
+	if (hit) {
+		mag->blocks[mag->count++] = block;
+		mag->free_hits++;
+	} else {
+		mag->free_misses++;
+	}
+
+	k_spin_unlock(&mag->lock, key);
+	arch_irq_unlock(irq_key);
+
+	if (hit && atomic_get(&slab->waiters) != 0) {
+		/* raced with an allocator that found the free list empty */
+		key = k_spin_lock(&lock);
+		if (magazine_reclaim(slab)) {
+			z_reschedule(&lock, key);
+		} else {
+			k_spin_unlock(&lock, key);
+		}
+	}
+
+	return hit;
+}
+
+int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
+{
+	k_spinlock_key_t key, mag_key;
+	struct z_mem_slab_magazine *mag;
+	bool waiting = false;
+	int result;
+
+	if (magazine_alloc(slab, mem)) {
+		return 0;
+	}
+
+	key = k_spin_lock(&lock);
+
+	if (slab->free_list == NULL) {
+		/* reclaim blocks cached by other CPUs before giving up */
+		atomic_inc(&slab->waiters);
+		waiting = true;
+		(void)magazine_reclaim(slab);
+	}
+
+	if (slab->free_list != NULL) {
+		/* take a free block and refill this CPU's magazine */
+		*mem = slab->free_list;
+		slab->free_list = *(char **)(slab->free_list);
+		slab->num_used++;
+
+		mag = local_magazine(slab);
+		mag_key = k_spin_lock(&mag->lock);
+
+		for (int i = 0; i < MAGAZINE_BATCH &&
+		     mag->count < CONFIG_MEM_SLAB_MAGAZINE_SIZE &&
+		     slab->free_list != NULL; i++) {
+			mag->blocks[mag->count++] = slab->free_list;
+			slab->free_list = *(char **)(slab->free_list);
+			slab->num_used++;
+		}
+
+		k_spin_unlock(&mag->lock, mag_key);
+		result = 0;
+	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		/* don't wait for a free block to become available */
+		*mem = NULL;
+		result = -ENOMEM;
+	} else {
+		/* wait for a free block or timeout */
+		result = z_pend_curr(&lock, key, &slab->wait_q, timeout);
+		if (result == 0) {
+			*mem = _current->base.swap_data;
+		}
+		atomic_dec(&slab->waiters);
+		return result;
+	}
+
+	if (waiting) {
+		atomic_dec(&slab->waiters);
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return result;
+}
+
+void k_mem_slab_free(struct k_mem_slab *slab, void **mem)
+{
+	k_spinlock_key_t key;
+	bool readied;
+
+	if (magazine_free(slab, *mem)) {
+		return;
+	}
+
+	key = k_spin_lock(&lock);
+
+	readied = slab_put(slab, *mem);
+	if (atomic_get(&slab->waiters) == 0) {
+		/* the local magazine is full: make room for the next frees */
+		readied |= magazine_drain(slab, local_magazine(slab),
+					  MAGAZINE_BATCH);
+	} else {
+		readied |= magazine_reclaim(slab);
+	}
+
+	if (readied) {
+		z_reschedule(&lock, key);
+	} else {
+		k_spin_unlock(&lock, key);
+	}
+}
+
+void k_mem_slab_magazine_stats_get(struct k_mem_slab *slab,
+				   struct k_mem_slab_magazine_stats *stats)
+{
+	(void)memset(stats, 0, sizeof(*stats));
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		struct z_mem_slab_magazine *mag = &slab->magazines[i];
+
+		stats->alloc_hits += mag->alloc_hits;
+		stats->alloc_misses += mag->alloc_misses;
+		stats->free_hits += mag->free_hits;
+		stats->free_misses += mag->free_misses;
+		stats->cached += mag->count;
+	}
+}
+
+#else
+
 int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 {
 	k_spinlock_key_t key = k_spin_lock(&lock);
@@ -146,3 +391,5 @@ void k_mem_slab_free(struct k_mem_slab *slab, void **mem)
 		k_spin_unlock(&lock, key);
 	}
 }
+
+#endif /* CONFIG_MEM_SLAB_MAGAZINE */
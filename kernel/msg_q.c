@@ -56,8 +56,10 @@ void k_msgq_init(struct k_msgq *msgq, char *buffer, size_t msg_size,
 	msgq->read_ptr = buffer;
 	msgq->write_ptr = buffer;
 	msgq->used_msgs = 0;
+	msgq->claimed_msgs = 0;
 	msgq->flags = 0;
 	z_waitq_init(&msgq->wait_q);
+	z_waitq_init(&msgq->claim_wait_q);
 	msgq->lock = (struct k_spinlock) {};
 
 	SYS_TRACING_OBJ_INIT(k_msgq, msgq);
@@ -101,7 +103,8 @@ int z_vrfy_k_msgq_alloc_init(struct k_msgq *q, size_t msg_size,
 
 int k_msgq_cleanup(struct k_msgq *msgq)
 {
-	CHECKIF(z_waitq_head(&msgq->wait_q) != NULL) {
+	CHECKIF((z_waitq_head(&msgq->wait_q) != NULL) ||
+		(z_waitq_head(&msgq->claim_wait_q) != NULL)) {
 		return -EBUSY;
 	}
 
@@ -113,6 +116,78 @@ int k_msgq_cleanup(struct k_msgq *msgq)
 }
 
 
+/* Copy num_msgs messages into the ring buffer at the write pointer */
+static void msgq_write(struct k_msgq *msgq, const char *data, u32_t num_msgs)
+{
+	size_t len = num_msgs * msgq->msg_size;
+	size_t room = msgq->buffer_end - msgq->write_ptr;
+
+	if (len >= room) {
+		(void)memcpy(msgq->write_ptr, data, room);
+		(void)memcpy(msgq->buffer_start, data + room, len - room);
+		msgq->write_ptr = msgq->buffer_start + (len - room);
+	} else {
+		(void)memcpy(msgq->write_ptr, data, len);
+		msgq->write_ptr += len;
+	}
+	msgq->used_msgs += num_msgs;
+}
+
+/* Copy num_msgs messages out of the ring buffer at the read pointer */
+static void msgq_read(struct k_msgq *msgq, char *data, u32_t num_msgs)
+{
+	size_t len = num_msgs * msgq->msg_size;
+	size_t room = msgq->buffer_end - msgq->read_ptr;
+
+	if (len >= room) {
+		(void)memcpy(data, msgq->read_ptr, room);
+		(void)memcpy(data + room, msgq->buffer_start, len - room);
+		msgq->read_ptr = msgq->buffer_start + (len - room);
+	} else {
+		(void)memcpy(data, msgq->read_ptr, len);
+		msgq->read_ptr += len;
+	}
+	msgq->used_msgs -= num_msgs;
+}
+
+/* Waits until no k_msgq_put_claim() reservation is open, as messages
+ * sent meanwhile would overtake the reserved ones.  Called and returns
+ * with the lock held, and leaves in *timeout what is left of it.
+ */
+static int msgq_wait_unclaimed(struct k_msgq *msgq, k_spinlock_key_t *key,
+			       k_timeout_t *timeout)
+{
+	u64_t end;
+
+	if (msgq->claimed_msgs == 0U) {
+		return 0;
+	}
+
+	if (K_TIMEOUT_EQ(*timeout, K_NO_WAIT)) {
+		return -EBUSY;
+	}
+
+	end = z_timeout_end_calc(*timeout);
+
+	do {
+		if (!K_TIMEOUT_EQ(*timeout, K_FOREVER)) {
+			s64_t left = (s64_t)(end - z_tick_get());
+
+			if (left <= 0) {
+				return -EAGAIN;
+			}
+			*timeout = Z_TIMEOUT_TICKS(left);
+		}
+
+		/* woken by k_msgq_put_commit(), or timed out */
+		(void)z_pend_curr(&msgq->lock, *key, &msgq->claim_wait_q,
+				  *timeout);
+		*key = k_spin_lock(&msgq->lock);
+	} while (msgq->claimed_msgs != 0U);
+
+	return 0;
+}
+
 int z_impl_k_msgq_put(struct k_msgq *msgq, void *data, k_timeout_t timeout)
 {
 	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
@@ -123,7 +198,10 @@ int z_impl_k_msgq_put(struct k_msgq *msgq, void *data, k_timeout_t timeout)
 
 	key = k_spin_lock(&msgq->lock);
 
-	if (msgq->used_msgs < msgq->max_msgs) {
+	result = msgq_wait_unclaimed(msgq, &key, &timeout);
+	if (result != 0) {
+		/* the tail of the queue is still reserved by a claim */
+	} else if (msgq->used_msgs < msgq->max_msgs) {
 		/* message queue isn't full */
 		pending_thread = z_unpend_first_thread(&msgq->wait_q);
 		if (pending_thread != NULL) {
@@ -171,6 +249,191 @@ static inline int z_vrfy_k_msgq_put(struct k_msgq *q, void *data,
 #include <syscalls/k_msgq_put_mrsh.c>
 #endif
 
+int z_impl_k_msgq_put_batch(struct k_msgq *msgq, const void *data,
+			    u32_t num_msgs, k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	const char *src = data;
+	struct k_thread *pending_thread;
+	k_spinlock_key_t key;
+	u32_t sent = 0U;
+	bool woken = false;
+	int result;
+
+	key = k_spin_lock(&msgq->lock);
+
+	result = (num_msgs == 0U) ? 0 :
+		 msgq_wait_unclaimed(msgq, &key, &timeout);
+
+	if ((num_msgs == 0U) || (result != 0)) {
+		/* nothing to send, or the tail of the queue is still
+		 * reserved by a claim
+		 */
+	} else if (msgq->used_msgs < msgq->max_msgs) {
+		/* message queue isn't full, so anyone waiting is a reader:
+		 * serve them first, then queue as many as fit
+		 */
+		while (sent < num_msgs) {
+			pending_thread = z_unpend_first_thread(&msgq->wait_q);
+			if (pending_thread == NULL) {
+				break;
+			}
+			(void)memcpy(pending_thread->base.swap_data, src,
+				     msgq->msg_size);
+			arch_thread_return_value_set(pending_thread, 0);
+			z_ready_thread(pending_thread);
+			src += msgq->msg_size;
+			sent++;
+			woken = true;
+		}
+
+		u32_t n = MIN(num_msgs - sent,
+			      msgq->max_msgs - msgq->used_msgs);
+
+		msgq_write(msgq, src, n);
+		result = sent + n;
+	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		/* don't wait for message space to become available */
+		result = -ENOMSG;
+	} else {
+		/* wait to put the first message, like k_msgq_put() */
+		_current->base.swap_data = (void *)data;
+		result = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+		return (result == 0) ? 1 : result;
+	}
+
+	if (woken) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return result;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_put_batch(struct k_msgq *q, const void *data,
+					  u32_t num_msgs, k_timeout_t timeout)
+{
+	size_t size;
+
+	Z_OOPS(Z_SYSCALL_OBJ(q, K_OBJ_MSGQ));
+	Z_OOPS(Z_SYSCALL_VERIFY_MSG(!size_mul_overflow(q->msg_size, num_msgs,
+						       &size),
+				    "message count overflow"));
+	Z_OOPS(Z_SYSCALL_MEMORY_READ(data, size));
+
+	return z_impl_k_msgq_put_batch(q, data, num_msgs, timeout);
+}
+#include <syscalls/k_msgq_put_batch_mrsh.c>
+#endif
+
+int z_impl_k_msgq_put_claim(struct k_msgq *msgq, void **data, u32_t num_msgs)
+{
+	k_spinlock_key_t key;
+	int result;
+
+	key = k_spin_lock(&msgq->lock);
+
+	if (num_msgs == 0U) {
+		result = -EINVAL;
+	} else if (msgq->claimed_msgs != 0U) {
+		result = -EBUSY;
+	} else if (msgq->used_msgs == msgq->max_msgs) {
+		result = -ENOMSG;
+	} else {
+		/* reserve contiguous slots only, up to the end of the ring */
+		u32_t contig = (msgq->buffer_end - msgq->write_ptr) /
+			       msgq->msg_size;
+
+		msgq->claimed_msgs = MIN(num_msgs,
+					 MIN(contig, msgq->max_msgs -
+						     msgq->used_msgs));
+		*data = msgq->write_ptr;
+		result = msgq->claimed_msgs;
+	}
+
+	k_spin_unlock(&msgq->lock, key);
+
+	return result;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_put_claim(struct k_msgq *q, void **data,
+					  u32_t num_msgs)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(q, K_OBJ_MSGQ));
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(data, sizeof(*data)));
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(q->buffer_start,
+				      q->buffer_end - q->buffer_start));
+
+	return z_impl_k_msgq_put_claim(q, data, num_msgs);
+}
+#include <syscalls/k_msgq_put_claim_mrsh.c>
+#endif
+
+int z_impl_k_msgq_put_commit(struct k_msgq *msgq, u32_t num_msgs)
+{
+	struct k_thread *pending_thread;
+	k_spinlock_key_t key;
+	bool woken = false;
+
+	key = k_spin_lock(&msgq->lock);
+
+	if (num_msgs > msgq->claimed_msgs) {
+		k_spin_unlock(&msgq->lock, key);
+		return -EINVAL;
+	}
+
+	msgq->claimed_msgs = 0U;
+	woken = z_unpend_all(&msgq->claim_wait_q) != 0;
+
+	for (u32_t i = 0U; i < num_msgs; i++) {
+		/* an empty queue may have readers waiting: hand them the
+		 * leading messages directly, the rest stay where they were
+		 * built
+		 */
+		pending_thread = (msgq->used_msgs == 0U) ?
+			z_unpend_first_thread(&msgq->wait_q) : NULL;
+		if (pending_thread != NULL) {
+			(void)memcpy(pending_thread->base.swap_data,
+				     msgq->write_ptr, msgq->msg_size);
+			arch_thread_return_value_set(pending_thread, 0);
+			z_ready_thread(pending_thread);
+			woken = true;
+		} else {
+			msgq->used_msgs++;
+		}
+
+		msgq->write_ptr += msgq->msg_size;
+		if (msgq->write_ptr == msgq->buffer_end) {
+			msgq->write_ptr = msgq->buffer_start;
+		}
+		if (pending_thread != NULL) {
+			msgq->read_ptr = msgq->write_ptr;
+		}
+	}
+
+	if (woken) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_put_commit(struct k_msgq *q, u32_t num_msgs)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(q, K_OBJ_MSGQ));
+
+	return z_impl_k_msgq_put_commit(q, num_msgs);
+}
+#include <syscalls/k_msgq_put_commit_mrsh.c>
+#endif
+
 void z_impl_k_msgq_get_attrs(struct k_msgq *msgq, struct k_msgq_attrs *attrs)
 {
 	attrs->msg_size = msgq->msg_size;
@@ -253,6 +516,73 @@ static inline int z_vrfy_k_msgq_get(struct k_msgq *q, void *data,
 #include <syscalls/k_msgq_get_mrsh.c>
 #endif
 
+int z_impl_k_msgq_get_batch(struct k_msgq *msgq, void *data, u32_t max_msgs,
+			    k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	struct k_thread *pending_thread;
+	k_spinlock_key_t key;
+	bool woken = false;
+	int result;
+
+	key = k_spin_lock(&msgq->lock);
+
+	if (max_msgs == 0U) {
+		result = 0;
+	} else if (msgq->used_msgs > 0) {
+		u32_t n = MIN(max_msgs, msgq->used_msgs);
+
+		msgq_read(msgq, data, n);
+
+		/* refill the freed slots from threads waiting to write */
+		while (msgq->used_msgs < msgq->max_msgs) {
+			pending_thread = z_unpend_first_thread(&msgq->wait_q);
+			if (pending_thread == NULL) {
+				break;
+			}
+			msgq_write(msgq, pending_thread->base.swap_data, 1);
+			arch_thread_return_value_set(pending_thread, 0);
+			z_ready_thread(pending_thread);
+			woken = true;
+		}
+		result = n;
+	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		/* don't wait for a message to become available */
+		result = -ENOMSG;
+	} else {
+		/* wait for a single message, like k_msgq_get() */
+		_current->base.swap_data = data;
+		result = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+		return (result == 0) ? 1 : result;
+	}
+
+	if (woken) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return result;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_get_batch(struct k_msgq *q, void *data,
+					  u32_t max_msgs, k_timeout_t timeout)
+{
+	size_t size;
+
+	Z_OOPS(Z_SYSCALL_OBJ(q, K_OBJ_MSGQ));
+	Z_OOPS(Z_SYSCALL_VERIFY_MSG(!size_mul_overflow(q->msg_size, max_msgs,
+						       &size),
+				    "message count overflow"));
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(data, size));
+
+	return z_impl_k_msgq_get_batch(q, data, max_msgs, timeout);
+}
+#include <syscalls/k_msgq_get_batch_mrsh.c>
+#endif
+
 int z_impl_k_msgq_peek(struct k_msgq *msgq, void *data)
 {
 	k_spinlock_key_t key;
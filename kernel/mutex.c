@@ -116,6 +116,47 @@ static bool adjust_owner_prio(struct k_mutex *mutex, s32_t new_prio)
 	return false;
 }
 
+#ifdef CONFIG_MUTEX_ADAPTIVE_SPIN
+/* The owner is running on another CPU: no CPU can run the current
+ * thread and the owner at the same time.
+ */
+static inline bool owner_is_running(struct k_thread *owner)
+{
+	return _kernel.cpus[owner->base.cpu].current == owner;
+}
+
+/* Spins, without the lock held, while the mutex stays held by the same
+ * running owner, for at most CONFIG_MUTEX_SPIN_US and never past the
+ * caller's timeout ending at tick "end".  Returns with the lock taken
+ * again, and the mutex possibly released.
+ */
+static k_spinlock_key_t mutex_spin(struct k_mutex *mutex,
+				   k_spinlock_key_t key, u64_t end)
+{
+	struct k_thread *owner = mutex->owner;
+	u32_t limit = k_us_to_cyc_ceil32(CONFIG_MUTEX_SPIN_US);
+	u32_t start;
+
+	k_spin_unlock(&lock, key);
+
+	if (end != UINT64_MAX) {
+		s64_t left = MAX((s64_t)(end - z_tick_get()), 0);
+
+		limit = (u32_t)MIN(limit, k_ticks_to_cyc_floor64(left));
+	}
+
+	start = k_cycle_get_32();
+	while ((*(volatile u32_t *)&mutex->lock_count != 0U) &&
+	       (*(struct k_thread * volatile *)&mutex->owner == owner) &&
+	       owner_is_running(owner) &&
+	       ((k_cycle_get_32() - start) < limit)) {
+		arch_nop();
+	}
+
+	return k_spin_lock(&lock);
+}
+#endif /* CONFIG_MUTEX_ADAPTIVE_SPIN */
+
 int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 {
 	int new_prio;
@@ -125,6 +166,29 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 	sys_trace_void(SYS_TRACE_ID_MUTEX_LOCK);
 	key = k_spin_lock(&lock);
 
+#ifdef CONFIG_MUTEX_ADAPTIVE_SPIN
+	if ((mutex->lock_count != 0U) && (mutex->owner != _current) &&
+	    !K_TIMEOUT_EQ(timeout, K_NO_WAIT) &&
+	    owner_is_running(mutex->owner)) {
+		u64_t end = z_timeout_end_calc(timeout);
+
+		key = mutex_spin(mutex, key, end);
+
+		/* Only wait for what is left of the timeout */
+		if ((end != UINT64_MAX) && (mutex->lock_count != 0U) &&
+		    (mutex->owner != _current)) {
+			s64_t left = (s64_t)(end - z_tick_get());
+
+			if (left <= 0) {
+				k_spin_unlock(&lock, key);
+				sys_trace_end_call(SYS_TRACE_ID_MUTEX_LOCK);
+				return -EAGAIN;
+			}
+			timeout = Z_TIMEOUT_TICKS(left);
+		}
+	}
+#endif
+
 	if (likely((mutex->lock_count == 0U) || (mutex->owner == _current))) {
 
 		mutex->owner_orig_prio = (mutex->lock_count == 0U) ?
@@ -135,6 +135,8 @@ void k_pipe_init(struct k_pipe *pipe, unsigned char *buffer, size_t size)
 	pipe->bytes_used = 0;
 	pipe->read_index = 0;
 	pipe->write_index = 0;
+	pipe->put_claimed = 0;
+	pipe->get_claimed = 0;
 	pipe->lock = (struct k_spinlock){};
 	z_waitq_init(&pipe->wait_q.writers);
 	z_waitq_init(&pipe->wait_q.readers);
@@ -424,6 +426,84 @@ static void pipe_thread_ready(struct k_thread *thread)
 	z_ready_thread(thread);
 }
 
+/**
+ * @brief Wait for a claim on the pipe's buffer to be finished
+ *
+ * Data moved by k_pipe_put() or k_pipe_get() while a claim of the same
+ * direction is open would overtake the claimed bytes, so the caller pends
+ * on @a wait_q with an empty request, like pipe_claim() does, until
+ * k_pipe_put_finish() or k_pipe_get_finish() wakes it up.
+ *
+ * Called and returns with @a pipe locked. What is left of the timeout is
+ * stored back in @a timeout.
+ *
+ * @return 0 once unclaimed, -EBUSY if @a timeout is K_NO_WAIT, -EAGAIN if
+ *         it expired
+ */
+static int pipe_wait_unclaimed(struct k_pipe *pipe, size_t *claimed,
+			       _wait_q_t *wait_q, k_spinlock_key_t *key,
+			       k_timeout_t *timeout)
+{
+	struct k_pipe_desc pipe_desc = { .buffer = NULL, .bytes_to_xfer = 0 };
+	u64_t end;
+
+	if (*claimed == 0) {
+		return 0;
+	}
+
+	if (K_TIMEOUT_EQ(*timeout, K_NO_WAIT)) {
+		return -EBUSY;
+	}
+
+	end = z_timeout_end_calc(*timeout);
+
+	do {
+		if (!K_TIMEOUT_EQ(*timeout, K_FOREVER)) {
+			s64_t remaining = (s64_t)(end - z_tick_get());
+
+			if (remaining <= 0) {
+				return -EAGAIN;
+			}
+			*timeout = K_TICKS(remaining);
+		}
+
+		_current->base.swap_data = &pipe_desc;
+		(void)z_pend_curr(&pipe->lock, *key, wait_q, *timeout);
+		*key = k_spin_lock(&pipe->lock);
+	} while (*claimed != 0);
+
+	return 0;
+}
+
+/**
+ * @brief Wake up the threads waiting on @a wait_q with an empty request
+ *
+ * These are the callers of pipe_wait_unclaimed() and pipe_claim(), which
+ * check again what they are waiting for. Called with the pipe locked.
+ */
+static void pipe_wake_empty_requests(_wait_q_t *wait_q)
+{
+	struct k_thread *thread;
+	struct k_thread *found;
+
+	do {
+		found = NULL;
+		_WAIT_Q_FOR_EACH(wait_q, thread) {
+			struct k_pipe_desc *desc = thread->base.swap_data;
+
+			if (desc->bytes_to_xfer == 0) {
+				found = thread;
+				break;
+			}
+		}
+
+		if (found != NULL) {
+			z_unpend_thread(found);
+			z_ready_thread(found);
+		}
+	} while (found != NULL);
+}
+
 /**
  * @brief Internal API used to send data to a pipe
  */
@@ -447,6 +527,19 @@ int z_pipe_put_internal(struct k_pipe *pipe, struct k_pipe_async *async_desc,
 	}
 
 	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+	int ret;
+
+	/* The buffer's free space may be claimed for writing in place.
+	 * Asynchronous senders cannot wait for that.
+	 */
+	ret = (async_desc != NULL && pipe->put_claimed != 0) ? -EBUSY :
+	      pipe_wait_unclaimed(pipe, &pipe->put_claimed,
+				  &pipe->wait_q.writers, &key, &timeout);
+	if (ret != 0) {
+		k_spin_unlock(&pipe->lock, key);
+		*bytes_written = 0;
+		return ret;
+	}
 
 	/*
 	 * Create a list of "working readers" into which the data will be
@@ -603,6 +696,16 @@ int z_impl_k_pipe_get(struct k_pipe *pipe, void *data, size_t bytes_to_read,
 	}
 
 	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+	int ret;
+
+	/* the buffer's data may be claimed for reading in place */
+	ret = pipe_wait_unclaimed(pipe, &pipe->get_claimed,
+				  &pipe->wait_q.readers, &key, &timeout);
+	if (ret != 0) {
+		k_spin_unlock(&pipe->lock, key);
+		*bytes_read = 0;
+		return ret;
+	}
 
 	/*
 	 * Create a list of "working readers" into which the data will be
@@ -806,6 +909,312 @@ void k_pipe_block_put(struct k_pipe *pipe, struct k_mem_block *block,
 }
 #endif
 
+/**
+ * @brief Hand data committed to the pipe's buffer to waiting readers
+ *
+ * Called with @a pipe locked; unlocks it and reschedules.
+ *
+ * @return N/A
+ */
+static void pipe_readers_fill(struct k_pipe *pipe, k_spinlock_key_t key)
+{
+	struct k_thread    *reader;
+	struct k_thread    *thread;
+	struct k_pipe_desc *desc;
+	sys_dlist_t    xfer_list;
+	size_t         bytes_copied;
+
+	(void)pipe_xfer_prepare(&xfer_list, &reader, &pipe->wait_q.readers,
+				 0, pipe->bytes_used, 0, K_FOREVER);
+
+	z_sched_lock();
+	k_spin_unlock(&pipe->lock, key);
+
+	thread = (struct k_thread *)sys_dlist_get(&xfer_list);
+	while (thread != NULL) {
+		desc = (struct k_pipe_desc *)thread->base.swap_data;
+		bytes_copied = pipe_buffer_get(pipe, desc->buffer,
+						desc->bytes_to_xfer);
+
+		desc->buffer        += bytes_copied;
+		desc->bytes_to_xfer -= bytes_copied;
+
+		/* The thread's read request has been satisfied. Ready it. */
+		z_ready_thread(thread);
+
+		thread = (struct k_thread *)sys_dlist_get(&xfer_list);
+	}
+
+	if (reader != NULL) {
+		desc = (struct k_pipe_desc *)reader->base.swap_data;
+		bytes_copied = pipe_buffer_get(pipe, desc->buffer,
+						desc->bytes_to_xfer);
+
+		desc->buffer        += bytes_copied;
+		desc->bytes_to_xfer -= bytes_copied;
+	}
+
+	k_sched_unlock();
+}
+
+/**
+ * @brief Refill space released from the pipe's buffer from waiting writers
+ *
+ * Called with @a pipe locked; unlocks it and reschedules.
+ *
+ * @return N/A
+ */
+static void pipe_writers_drain(struct k_pipe *pipe, k_spinlock_key_t key)
+{
+	struct k_thread    *writer;
+	struct k_thread    *thread;
+	struct k_pipe_desc *desc;
+	sys_dlist_t    xfer_list;
+	size_t         bytes_copied;
+
+	(void)pipe_xfer_prepare(&xfer_list, &writer, &pipe->wait_q.writers,
+				 0, pipe->size - pipe->bytes_used, 0,
+				 K_FOREVER);
+
+	z_sched_lock();
+	k_spin_unlock(&pipe->lock, key);
+
+	thread = (struct k_thread *)sys_dlist_get(&xfer_list);
+	while (thread != NULL) {
+		desc = (struct k_pipe_desc *)thread->base.swap_data;
+		bytes_copied = pipe_buffer_put(pipe, desc->buffer,
+						desc->bytes_to_xfer);
+
+		desc->buffer         += bytes_copied;
+		desc->bytes_to_xfer  -= bytes_copied;
+
+		/* Write request has been satisfied */
+		pipe_thread_ready(thread);
+
+		thread = (struct k_thread *)sys_dlist_get(&xfer_list);
+	}
+
+	if (writer != NULL) {
+		desc = (struct k_pipe_desc *)writer->base.swap_data;
+		bytes_copied = pipe_buffer_put(pipe, desc->buffer,
+						desc->bytes_to_xfer);
+
+		desc->buffer         += bytes_copied;
+		desc->bytes_to_xfer  -= bytes_copied;
+	}
+
+	k_sched_unlock();
+}
+
+/**
+ * @brief Claim a contiguous run of the pipe's buffer
+ *
+ * Common code for k_pipe_put_claim() and k_pipe_get_claim(). @a avail
+ * returns the length of the run that can be claimed at @a index. While
+ * it is too short the caller pends on @a wait_q with an empty request;
+ * the other side wakes it up like any satisfied reader or writer once it
+ * has moved data through the pipe.
+ *
+ * @return See k_pipe_put_claim()
+ */
+static int pipe_claim(struct k_pipe *pipe, size_t *claimed, size_t *index,
+		      size_t (*avail)(struct k_pipe *pipe), _wait_q_t *wait_q,
+		      u8_t **data, size_t bytes_to_xfer, size_t *bytes_claimed,
+		      size_t min_xfer, k_timeout_t timeout)
+{
+	struct k_pipe_desc pipe_desc = { .buffer = NULL, .bytes_to_xfer = 0 };
+	u64_t end = z_timeout_end_calc(timeout);
+	k_timeout_t wait = timeout;
+	k_spinlock_key_t key;
+	size_t run;
+	int ret;
+
+	CHECKIF((min_xfer > bytes_to_xfer) || (min_xfer > pipe->size) ||
+		(pipe->size == 0) || (bytes_claimed == NULL)) {
+		return -EINVAL;
+	}
+
+	*bytes_claimed = 0;
+
+	key = k_spin_lock(&pipe->lock);
+
+	while (true) {
+		if (*claimed != 0) {
+			ret = -EBUSY;
+			break;
+		}
+
+		run = avail(pipe);
+		if ((run >= min_xfer) ||
+		    ((run > 0) && (*index + run == pipe->size))) {
+			run = MIN(run, bytes_to_xfer);
+			*claimed = run;
+			*data = pipe->buffer + *index;
+			*bytes_claimed = run;
+			ret = 0;
+			break;
+		}
+
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			ret = -EIO;
+			break;
+		}
+
+		if (!K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+			s64_t remaining = (s64_t)(end - z_tick_get());
+
+			if (remaining <= 0) {
+				ret = -EAGAIN;
+				break;
+			}
+			wait = K_TICKS(remaining);
+		}
+
+		_current->base.swap_data = &pipe_desc;
+		(void)z_pend_curr(&pipe->lock, key, wait_q, wait);
+		key = k_spin_lock(&pipe->lock);
+	}
+
+	k_spin_unlock(&pipe->lock, key);
+
+	return ret;
+}
+
+static size_t pipe_put_avail(struct k_pipe *pipe)
+{
+	if (pipe->bytes_used == 0) {
+		/* Empty: rewind so that the whole buffer is contiguous */
+		pipe->read_index = 0;
+		pipe->write_index = 0;
+	}
+
+	return MIN(pipe->size - pipe->bytes_used,
+		   pipe->size - pipe->write_index);
+}
+
+static size_t pipe_get_avail(struct k_pipe *pipe)
+{
+	return MIN(pipe->bytes_used, pipe->size - pipe->read_index);
+}
+
+int z_impl_k_pipe_put_claim(struct k_pipe *pipe, u8_t **data,
+			    size_t bytes_to_write, size_t *bytes_claimed,
+			    size_t min_xfer, k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	return pipe_claim(pipe, &pipe->put_claimed, &pipe->write_index,
+			  pipe_put_avail, &pipe->wait_q.writers, data,
+			  bytes_to_write, bytes_claimed, min_xfer, timeout);
+}
+
+#ifdef CONFIG_USERSPACE
+int z_vrfy_k_pipe_put_claim(struct k_pipe *pipe, u8_t **data,
+			    size_t bytes_to_write, size_t *bytes_claimed,
+			    size_t min_xfer, k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(pipe, K_OBJ_PIPE));
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(data, sizeof(*data)));
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(bytes_claimed, sizeof(*bytes_claimed)));
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(pipe->buffer, pipe->size));
+
+	return z_impl_k_pipe_put_claim(pipe, data, bytes_to_write,
+				       bytes_claimed, min_xfer, timeout);
+}
+#include <syscalls/k_pipe_put_claim_mrsh.c>
+#endif
+
+int z_impl_k_pipe_put_finish(struct k_pipe *pipe, size_t bytes_written)
+{
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+	if (bytes_written > pipe->put_claimed) {
+		k_spin_unlock(&pipe->lock, key);
+		return -EINVAL;
+	}
+
+	pipe->put_claimed = 0;
+	pipe_wake_empty_requests(&pipe->wait_q.writers);
+	pipe->bytes_used += bytes_written;
+	pipe->write_index += bytes_written;
+	if (pipe->write_index == pipe->size) {
+		pipe->write_index = 0;
+	}
+
+	pipe_readers_fill(pipe, key);
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+int z_vrfy_k_pipe_put_finish(struct k_pipe *pipe, size_t bytes_written)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(pipe, K_OBJ_PIPE));
+
+	return z_impl_k_pipe_put_finish(pipe, bytes_written);
+}
+#include <syscalls/k_pipe_put_finish_mrsh.c>
+#endif
+
+int z_impl_k_pipe_get_claim(struct k_pipe *pipe, u8_t **data,
+			    size_t bytes_to_read, size_t *bytes_claimed,
+			    size_t min_xfer, k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	return pipe_claim(pipe, &pipe->get_claimed, &pipe->read_index,
+			  pipe_get_avail, &pipe->wait_q.readers, data,
+			  bytes_to_read, bytes_claimed, min_xfer, timeout);
+}
+
+#ifdef CONFIG_USERSPACE
+int z_vrfy_k_pipe_get_claim(struct k_pipe *pipe, u8_t **data,
+			    size_t bytes_to_read, size_t *bytes_claimed,
+			    size_t min_xfer, k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(pipe, K_OBJ_PIPE));
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(data, sizeof(*data)));
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(bytes_claimed, sizeof(*bytes_claimed)));
+	Z_OOPS(Z_SYSCALL_MEMORY_READ(pipe->buffer, pipe->size));
+
+	return z_impl_k_pipe_get_claim(pipe, data, bytes_to_read,
+				       bytes_claimed, min_xfer, timeout);
+}
+#include <syscalls/k_pipe_get_claim_mrsh.c>
+#endif
+
+int z_impl_k_pipe_get_finish(struct k_pipe *pipe, size_t bytes_read)
+{
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+	if (bytes_read > pipe->get_claimed) {
+		k_spin_unlock(&pipe->lock, key);
+		return -EINVAL;
+	}
+
+	pipe->get_claimed = 0;
+	pipe_wake_empty_requests(&pipe->wait_q.readers);
+	pipe->bytes_used -= bytes_read;
+	pipe->read_index += bytes_read;
+	if (pipe->read_index == pipe->size) {
+		pipe->read_index = 0;
+	}
+
+	pipe_writers_drain(pipe, key);
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+int z_vrfy_k_pipe_get_finish(struct k_pipe *pipe, size_t bytes_read)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(pipe, K_OBJ_PIPE));
+
+	return z_impl_k_pipe_get_finish(pipe, bytes_read);
+}
+#include <syscalls/k_pipe_get_finish_mrsh.c>
+#endif
+
 size_t z_impl_k_pipe_read_avail(struct k_pipe *pipe)
 {
 	size_t res;
@@ -827,6 +1236,9 @@ size_t z_impl_k_pipe_read_avail(struct k_pipe *pipe)
 		res = pipe->size - (pipe->read_index - pipe->write_index);
 	}
 
+	/* data claimed for reading in place is no longer available */
+	res -= pipe->get_claimed;
+
 	k_spin_unlock(&pipe->lock, key);
 
 out:
@@ -864,6 +1276,9 @@ size_t z_impl_k_pipe_write_avail(struct k_pipe *pipe)
 		res = pipe->size - (pipe->write_index - pipe->read_index);
 	}
 
+	/* space claimed for writing in place is no longer available */
+	res -= pipe->put_claimed;
+
 	k_spin_unlock(&pipe->lock, key);
 
 out:
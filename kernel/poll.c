@@ -84,6 +84,17 @@ static inline bool is_condition_met(struct k_poll_event *event, u32_t *state)
 	return false;
 }
 
+/* Poll sets have no thread of their own, and rank below any thread */
+static inline bool is_poller_higher_prio(struct _poller *p1,
+					 struct _poller *p2)
+{
+	if (p1->thread == NULL || p2->thread == NULL) {
+		return p2->thread == NULL && p1->thread != NULL;
+	}
+
+	return z_is_t1_higher_prio_than_t2(p1->thread, p2->thread);
+}
+
 static inline void add_event(sys_dlist_t *events, struct k_poll_event *event,
 			     struct _poller *poller)
 {
@@ -91,15 +102,13 @@ static inline void add_event(sys_dlist_t *events, struct k_poll_event *event,
 
 	pending = (struct k_poll_event *)sys_dlist_peek_tail(events);
 	if ((pending == NULL) ||
-		z_is_t1_higher_prio_than_t2(pending->poller->thread,
-					    poller->thread)) {
+		!is_poller_higher_prio(poller, pending->poller)) {
 		sys_dlist_append(events, &event->_node);
 		return;
 	}
 
 	SYS_DLIST_FOR_EACH_CONTAINER(events, pending, _node) {
-		if (z_is_t1_higher_prio_than_t2(poller->thread,
-						pending->poller->thread)) {
+		if (is_poller_higher_prio(poller, pending->poller)) {
 			sys_dlist_insert(&pending->_node, &event->_node);
 			return;
 		}
@@ -483,6 +492,245 @@ static inline void z_vrfy_k_poll_signal_reset(struct k_poll_signal *signal)
 
 #endif
 
+/* must be called with interrupts locked */
+static void poll_set_ready(struct k_poll_set *set, struct k_poll_event *event)
+{
+	struct k_thread *thread;
+
+	sys_dlist_append(&set->ready, &event->_node);
+
+	thread = z_unpend_first_thread(&set->wait_q);
+	if (thread != NULL) {
+		arch_thread_return_value_set(thread, 0);
+		z_ready_thread(thread);
+	}
+}
+
+/* must be called with interrupts locked */
+int z_poll_set_event_cb(struct k_poll_event *event, u32_t state)
+{
+	ARG_UNUSED(state);
+
+	/* The object has already unlinked the event from its list */
+	poll_set_ready(CONTAINER_OF(event->poller, struct k_poll_set, poller),
+		       event);
+	return 0;
+}
+
+/* must be called with interrupts locked */
+static void poll_set_arm(struct k_poll_set *set, struct k_poll_event *event)
+{
+	u32_t state;
+
+	if (is_condition_met(event, &state)) {
+		set_event_ready(event, state);
+		poll_set_ready(set, event);
+	} else {
+		(void)register_event(event, &set->poller);
+	}
+}
+
+/* Reports up to max events off the ready list, checking each one
+ * again first: an event whose condition no longer holds goes back to
+ * its object, the others are moved to the tail of the list so that
+ * the next call reports the rest first.  Must be called with
+ * interrupts locked.
+ */
+static int poll_set_collect(struct k_poll_set *set,
+			    struct k_poll_event *ready, int max)
+{
+	sys_dnode_t *last = sys_dlist_peek_tail(&set->ready);
+	int n = 0;
+
+	while (n < max && last != NULL) {
+		sys_dnode_t *node = sys_dlist_get(&set->ready);
+		struct k_poll_event *event =
+			CONTAINER_OF(node, struct k_poll_event, _node);
+		u32_t state = event->state & K_POLL_STATE_CANCELLED;
+		u32_t met;
+
+		if (is_condition_met(event, &met)) {
+			state |= met;
+		}
+		event->state = K_POLL_STATE_NOT_READY;
+
+		if (state != K_POLL_STATE_NOT_READY) {
+			ready[n++] = (struct k_poll_event) {
+				.tag = event->tag,
+				.type = event->type,
+				.state = state,
+				.mode = event->mode,
+				.obj = event->obj,
+			};
+			sys_dlist_append(&set->ready, node);
+		} else {
+			(void)register_event(event, &set->poller);
+		}
+
+		if (node == last) {
+			break;
+		}
+	}
+
+	return n;
+}
+
+void k_poll_set_init(struct k_poll_set *set,
+		     struct k_poll_event *events, int num_events)
+{
+	__ASSERT(num_events >= 0, "<0 events\n");
+
+	set->events = events;
+	set->num_events = num_events;
+	sys_dlist_init(&set->ready);
+	z_waitq_init(&set->wait_q);
+	set->poller.is_polling = false;
+	set->poller.thread = NULL;
+	set->poller.cb = z_poll_set_event_cb;
+
+	for (int i = 0; i < num_events; i++) {
+		events[i].obj = NULL;
+	}
+
+	z_object_init(set);
+}
+
+int z_impl_k_poll_set_add(struct k_poll_set *set, u32_t type, void *obj,
+			  u32_t tag)
+{
+	struct k_poll_event *event = NULL;
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	for (int i = 0; i < set->num_events; i++) {
+		if (set->events[i].obj == obj) {
+			k_spin_unlock(&lock, key);
+			return -EALREADY;
+		}
+		if (event == NULL && set->events[i].obj == NULL) {
+			event = &set->events[i];
+		}
+	}
+
+	if (event == NULL) {
+		k_spin_unlock(&lock, key);
+		return -ENOMEM;
+	}
+
+	k_poll_event_init(event, type, K_POLL_MODE_NOTIFY_ONLY, obj);
+	event->tag = tag;
+	poll_set_arm(set, event);
+
+	z_reschedule(&lock, key);
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_poll_set_add(struct k_poll_set *set, u32_t type,
+					void *obj, u32_t tag)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(set, K_OBJ_POLL_SET));
+
+	switch (type) {
+	case K_POLL_TYPE_SIGNAL:
+		Z_OOPS(Z_SYSCALL_OBJ(obj, K_OBJ_POLL_SIGNAL));
+		break;
+	case K_POLL_TYPE_SEM_AVAILABLE:
+		Z_OOPS(Z_SYSCALL_OBJ(obj, K_OBJ_SEM));
+		break;
+	case K_POLL_TYPE_DATA_AVAILABLE:
+		Z_OOPS(Z_SYSCALL_OBJ(obj, K_OBJ_QUEUE));
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	return z_impl_k_poll_set_add(set, type, obj, tag);
+}
+#include <syscalls/k_poll_set_add_mrsh.c>
+#endif
+
+int z_impl_k_poll_set_remove(struct k_poll_set *set, void *obj)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	for (int i = 0; i < set->num_events; i++) {
+		struct k_poll_event *event = &set->events[i];
+
+		if (event->obj != obj) {
+			continue;
+		}
+
+		/* On either its object's list or the ready list */
+		if (sys_dnode_is_linked(&event->_node)) {
+			sys_dlist_remove(&event->_node);
+		}
+		event->poller = NULL;
+		event->obj = NULL;
+
+		k_spin_unlock(&lock, key);
+		return 0;
+	}
+
+	k_spin_unlock(&lock, key);
+	return -ENOENT;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_poll_set_remove(struct k_poll_set *set, void *obj)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(set, K_OBJ_POLL_SET));
+	return z_impl_k_poll_set_remove(set, obj);
+}
+#include <syscalls/k_poll_set_remove_mrsh.c>
+#endif
+
+int z_impl_k_poll_set_wait(struct k_poll_set *set,
+			   struct k_poll_event *ready, int max,
+			   k_timeout_t timeout)
+{
+	u64_t end = z_timeout_end_calc(timeout);
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	int n;
+
+	__ASSERT(max > 0, "no room for events\n");
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	while ((n = poll_set_collect(set, ready, max)) == 0) {
+		s64_t remaining = (s64_t)(end - z_tick_get());
+
+		if (K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+			(void)z_pend_curr(&lock, key, &set->wait_q, K_FOREVER);
+		} else if (remaining > 0) {
+			(void)z_pend_curr(&lock, key, &set->wait_q,
+					  K_TICKS(remaining));
+		} else {
+			k_spin_unlock(&lock, key);
+			return -EAGAIN;
+		}
+
+		key = k_spin_lock(&lock);
+	}
+
+	k_spin_unlock(&lock, key);
+	return n;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_poll_set_wait(struct k_poll_set *set,
+					 struct k_poll_event *ready, int max,
+					 k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(set, K_OBJ_POLL_SET));
+	if (Z_SYSCALL_VERIFY(max > 0)) {
+		return -EINVAL;
+	}
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_WRITE(ready, max,
+					    sizeof(struct k_poll_event)));
+	return z_impl_k_poll_set_wait(set, ready, max, timeout);
+}
+#include <syscalls/k_poll_set_wait_mrsh.c>
+#endif
+
 static void triggered_work_handler(struct k_work *work)
 {
 	k_work_handler_t handler;
@@ -54,6 +54,7 @@
 struct z_kernel _kernel;
 
 static struct k_spinlock sched_spinlock;
+Z_SPINLOCK_STATS_DEFINE(sched_spinlock, sched_spinlock);
 
 #define LOCKED(lck) for (k_spinlock_key_t __i = {},			\
 					  __key = k_spin_lock(lck);	\
@@ -276,15 +277,114 @@ static int slice_max_prio;
 static struct k_thread *pending_current;
 #endif
 
-void z_reset_time_slice(void)
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+static void update_cache(int preempt_ok);
+
+/* Save what is left of the budget of the thread the time slice was
+ * armed for.  Always leave at least one tick: a thread that used up
+ * its budget between two ticks is caught at the next one.
+ */
+static void cbs_charge(void)
+{
+	struct k_thread *thread = _current_cpu->cbs_thread;
+
+	if (thread != NULL) {
+		int left = _current_cpu->slice_ticks - (int)z_clock_elapsed();
+
+		thread->base.cbs_remaining = MAX(left, 1);
+		_current_cpu->cbs_thread = NULL;
+	}
+}
+
+/* Budget exhausted: start a new period, and requeue the thread with
+ * its postponed deadline.
+ */
+static void cbs_replenish(struct k_thread *thread)
+{
+	LOCKED(&sched_spinlock) {
+		if (z_is_thread_queued(thread)) {
+			_priq_run_remove(&_kernel.ready_q.runq, thread);
+		}
+		thread->base.cbs_remaining = thread->base.cbs_budget;
+		thread->base.prio_deadline += thread->base.cbs_period;
+		_priq_run_add(&_kernel.ready_q.runq, thread);
+		z_mark_thread_as_queued(thread);
+		update_cache(thread == _current);
+	}
+}
+
+/* CBS wakeup rule: if the thread can't use what is left of its budget
+ * before its deadline without exceeding its bandwidth, it starts a new
+ * period instead.  Called with the thread out of the run queue.
+ */
+static void cbs_wakeup(struct k_thread *thread)
+{
+	int now = (int) k_cycle_get_32();
+	int dt = thread->base.prio_deadline - now;
+
+	if (thread->base.cbs_budget == 0) {
+		return;
+	}
+
+	if ((dt <= 0) ||
+	    ((s64_t)thread->base.cbs_remaining * thread->base.cbs_period >=
+	     (s64_t)dt * thread->base.cbs_budget)) {
+		thread->base.cbs_remaining = thread->base.cbs_budget;
+		thread->base.prio_deadline = now + thread->base.cbs_period;
+	}
+}
+#endif
+
+/* The thread which will be running once the current scheduling
+ * decision has taken effect.  On SMP, the context switch will reset
+ * the time slice again if it is not _current.
+ */
+static inline struct k_thread *slice_next(void)
+{
+#ifdef CONFIG_SMP
+	return _current;
+#else
+	return _kernel.ready_q.cache;
+#endif
+}
+
+static void slice_arm(int ticks)
 {
+	/* The timer must be compared against the other timeouts only:
+	 * next_timeout() would otherwise already see the new slice and
+	 * never program it.
+	 */
+	_current_cpu->slice_ticks = 0;
+	z_set_timeout_expiry(ticks, false);
+
 	/* Add the elapsed time since the last announced tick to the
 	 * slice count, as we'll see those "expired" ticks arrive in a
 	 * FUTURE z_time_slice() call.
 	 */
+	_current_cpu->slice_ticks = ticks + z_clock_elapsed();
+}
+
+void z_reset_time_slice(struct k_thread *curr)
+{
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	cbs_charge();
+
+	if ((curr->base.cbs_budget != 0) && is_preempt(curr)) {
+		_current_cpu->cbs_thread = curr;
+		slice_arm(curr->base.cbs_remaining);
+		return;
+	}
+#endif
+
+#ifdef CONFIG_TIMESLICE_PER_THREAD
+	if (curr->base.slice_ticks != 0) {
+		slice_arm(curr->base.slice_ticks);
+		return;
+	}
+#endif
+
 	if (slice_time != 0) {
-		_current_cpu->slice_ticks = slice_time + z_clock_elapsed();
-		z_set_timeout_expiry(slice_time, false);
+		slice_arm(slice_time);
 	}
 }
 
@@ -294,16 +394,41 @@ void k_sched_time_slice_set(s32_t slice, int prio)
 		_current_cpu->slice_ticks = 0;
 		slice_time = k_ms_to_ticks_ceil32(slice);
 		slice_max_prio = prio;
-		z_reset_time_slice();
+		z_reset_time_slice(_current);
+	}
+}
+
+#ifdef CONFIG_TIMESLICE_PER_THREAD
+void k_thread_time_slice_set(struct k_thread *thread, s32_t slice,
+			     k_thread_timeslice_fn_t expired, void *data)
+{
+	LOCKED(&sched_spinlock) {
+		thread->base.slice_ticks = k_ms_to_ticks_ceil32(slice);
+		thread->base.slice_expired = expired;
+		thread->base.slice_data = data;
+		if (thread == _current) {
+			z_reset_time_slice(_current);
+		}
 	}
 }
+#endif
 
 static inline int sliceable(struct k_thread *thread)
 {
-	return is_preempt(thread)
-		&& !z_is_prio_higher(thread->base.prio, slice_max_prio)
-		&& !z_is_idle_thread_object(thread)
-		&& !z_is_thread_timeout_active(thread);
+	if (!is_preempt(thread)
+	    || z_is_idle_thread_object(thread)
+	    || z_is_thread_timeout_active(thread)) {
+		return 0;
+	}
+
+#ifdef CONFIG_TIMESLICE_PER_THREAD
+	if (thread->base.slice_ticks != 0) {
+		return 1;
+	}
+#endif
+
+	return slice_time != 0
+		&& !z_is_prio_higher(thread->base.prio, slice_max_prio);
 }
 
 /* Called out of each timer interrupt */
@@ -311,16 +436,41 @@ void z_time_slice(int ticks)
 {
 #ifdef CONFIG_SWAP_NONATOMIC
 	if (pending_current == _current) {
-		z_reset_time_slice();
+		z_reset_time_slice(_current);
 		return;
 	}
 	pending_current = NULL;
 #endif
 
-	if (slice_time && sliceable(_current)) {
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	if (_current_cpu->cbs_thread == _current) {
 		if (ticks >= _current_cpu->slice_ticks) {
-			z_move_thread_to_end_of_prio_q(_current);
-			z_reset_time_slice();
+			_current_cpu->cbs_thread = NULL;
+			cbs_replenish(_current);
+			z_reset_time_slice(slice_next());
+		} else {
+			_current_cpu->slice_ticks -= ticks;
+		}
+		return;
+	}
+#endif
+
+	if (sliceable(_current)) {
+		if (ticks >= _current_cpu->slice_ticks) {
+#ifdef CONFIG_THREAD_RUNTIME_STATS
+			_current->rt_stats.slice_expirations++;
+#endif
+#ifdef CONFIG_TIMESLICE_PER_THREAD
+			if (_current->base.slice_expired != NULL) {
+				_current->base.slice_expired(_current,
+						_current->base.slice_data);
+			}
+#endif
+			/* The callback may have suspended the thread */
+			if (!z_is_thread_prevented_from_running(_current)) {
+				z_move_thread_to_end_of_prio_q(_current);
+			}
+			z_reset_time_slice(slice_next());
 		} else {
 			_current_cpu->slice_ticks -= ticks;
 		}
@@ -356,7 +506,7 @@ static void update_cache(int preempt_ok)
 	if (should_preempt(thread, preempt_ok)) {
 #ifdef CONFIG_TIMESLICING
 		if (thread != _current) {
-			z_reset_time_slice();
+			z_reset_time_slice(thread);
 		}
 #endif
 		update_metairq_preempt(thread);
@@ -380,6 +530,12 @@ static void ready_thread(struct k_thread *thread)
 {
 	if (z_is_thread_ready(thread)) {
 		sys_trace_thread_ready(thread);
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+		cbs_wakeup(thread);
+#endif
+#ifdef CONFIG_THREAD_RUNTIME_STATS
+		z_thread_mark_ready(thread);
+#endif
 		_priq_run_add(&_kernel.ready_q.runq, thread);
 		z_mark_thread_as_queued(thread);
 		update_cache(0);
@@ -806,6 +962,9 @@ struct k_thread *z_get_next_ready_thread(void)
 static inline void set_current(struct k_thread *new_thread)
 {
 	_current_cpu->current = new_thread;
+#ifdef CONFIG_THREAD_RUNTIME_STATS
+	z_thread_mark_switched_in();
+#endif
 }
 
 #ifdef CONFIG_USE_SWITCH
@@ -823,9 +982,10 @@ void *z_get_next_switch_handle(void *interrupted)
 			update_metairq_preempt(thread);
 
 #ifdef CONFIG_TIMESLICING
-			z_reset_time_slice();
+			z_reset_time_slice(thread);
 #endif
 			_current_cpu->swap_ok = 0;
+			thread->base.cpu = _current_cpu->id;
 			set_current(thread);
 #ifdef CONFIG_SPIN_VALIDATE
 			/* Changed _current!  Update the spinlock
@@ -1113,6 +1273,57 @@ static inline void z_vrfy_k_thread_deadline_set(k_tid_t tid, int deadline)
 }
 #include <syscalls/k_thread_deadline_set_mrsh.c>
 #endif
+
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+void z_impl_k_thread_deadline_budget_set(k_tid_t tid, int budget,
+					 int period)
+{
+	struct k_thread *thread = tid;
+
+	LOCKED(&sched_spinlock) {
+		bool queued = z_is_thread_queued(thread);
+
+		if (queued) {
+			_priq_run_remove(&_kernel.ready_q.runq, thread);
+		}
+
+		thread->base.cbs_budget =
+			(budget != 0) ? k_cyc_to_ticks_ceil32(budget) : 0;
+		thread->base.cbs_remaining = thread->base.cbs_budget;
+		thread->base.cbs_period = period;
+		if (budget != 0) {
+			thread->base.prio_deadline = k_cycle_get_32() + period;
+		}
+
+		if (queued) {
+			_priq_run_add(&_kernel.ready_q.runq, thread);
+		}
+
+		if (thread == _current) {
+			/* Start over with the new budget */
+			_current_cpu->cbs_thread = NULL;
+			z_reset_time_slice(_current);
+		}
+	}
+}
+
+#ifdef CONFIG_USERSPACE
+static inline void z_vrfy_k_thread_deadline_budget_set(k_tid_t tid,
+						       int budget, int period)
+{
+	struct k_thread *thread = tid;
+
+	Z_OOPS(Z_SYSCALL_OBJ(thread, K_OBJ_THREAD));
+	Z_OOPS(Z_SYSCALL_VERIFY_MSG(period > 0,
+				    "invalid budget period %d", period));
+	Z_OOPS(Z_SYSCALL_VERIFY_MSG(budget >= 0 && budget <= period,
+				    "invalid thread budget %d", budget));
+
+	z_impl_k_thread_deadline_budget_set((k_tid_t)thread, budget, period);
+}
+#include <syscalls/k_thread_deadline_budget_set_mrsh.c>
+#endif
+#endif
 #endif
 
 void z_impl_k_yield(void)
@@ -1272,6 +1483,9 @@ void z_sched_ipi(void)
 	/* NOTE: When adding code to this, make sure this is called
 	 * at appropriate location when !CONFIG_SCHED_IPI_SUPPORTED.
 	 */
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	z_timeout_ipi();
+#endif
 }
 
 void z_sched_abort(struct k_thread *thread)
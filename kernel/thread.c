@@ -474,6 +474,12 @@ void z_setup_new_thread(struct k_thread *new_thread,
 
 	z_waitq_init(&new_thread->base.join_waiters);
 
+#ifdef CONFIG_THREAD_LOCAL_STORAGE
+	/* reserve space on top of stack for thread local storage */
+	stack_size = Z_STACK_PTR_ALIGN(stack_size -
+		arch_tls_stack_setup(new_thread,
+				     Z_THREAD_STACK_BUFFER(stack) + stack_size));
+#endif
 #ifdef CONFIG_THREAD_USERSPACE_LOCAL_DATA
 #ifndef CONFIG_THREAD_USERSPACE_LOCAL_DATA_ARCH_DEFER_SETUP
 	/* reserve space on top of stack for local data */
@@ -489,6 +495,10 @@ void z_setup_new_thread(struct k_thread *new_thread,
 	/* static threads overwrite it afterwards with real value */
 	new_thread->init_data = NULL;
 	new_thread->fn_abort = NULL;
+#ifdef CONFIG_THREAD_RUNTIME_STATS
+	(void)memset(&new_thread->rt_stats, 0, sizeof(new_thread->rt_stats));
+	new_thread->ready_stamp = 0U;
+#endif
 
 #ifdef CONFIG_USE_SWITCH
 	/* switch_handle must be non-null except when inside z_swap()
@@ -564,6 +574,13 @@ void z_setup_new_thread(struct k_thread *new_thread,
 #endif
 #ifdef CONFIG_SCHED_DEADLINE
 	new_thread->base.prio_deadline = 0;
+#endif
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	new_thread->base.cbs_budget = 0;
+#endif
+#ifdef CONFIG_TIMESLICE_PER_THREAD
+	new_thread->base.slice_ticks = 0;
+	new_thread->base.slice_expired = NULL;
 #endif
 	new_thread->resource_pool = _current->resource_pool;
 	sys_trace_thread_create(new_thread);
@@ -751,8 +768,10 @@ FUNC_NORETURN void k_thread_user_mode_enter(k_thread_entry_t entry,
 	_current->entry.parameter3 = p3;
 #endif
 #ifdef CONFIG_USERSPACE
+#ifdef CONFIG_THREAD_USERSPACE_LOCAL_DATA
 	memset(_current->userspace_local_data, 0,
 	       sizeof(struct _thread_userspace_local_data));
+#endif
 	arch_user_mode_enter(entry, p1, p2, p3);
 #else
 	/* XXX In this case we do not reset the stack */
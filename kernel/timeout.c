@@ -19,9 +19,14 @@
 
 static u64_t curr_tick;
 
-static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
-
+/* Protects curr_tick, and the timeout queue itself unless
+ * CONFIG_TIMEOUT_QUEUE_PER_CPU gives each CPU's queue its own lock.
+ * With per-CPU queues only announcing, and programming the system
+ * timer, take it: curr_tick is then also readable without it, see
+ * get_curr_tick().
+ */
 static struct k_spinlock timeout_lock;
+Z_SPINLOCK_STATS_DEFINE(timeout_lock, timeout_lock);
 
 #define MAX_WAIT (IS_ENABLED(CONFIG_SYSTEM_CLOCK_SLOPPY_IDLE) \
 		  ? K_TICKS_FOREVER : INT_MAX)
@@ -41,39 +46,492 @@ static inline int z_vrfy_z_clock_hw_cycles_per_sec_runtime_get(void)
 #endif /* CONFIG_USERSPACE */
 #endif /* CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME */
 
-static struct _timeout *first(void)
+static s32_t elapsed(void)
+{
+	return announce_remaining == 0 ? z_clock_elapsed() : 0;
+}
+
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+/* Sequence counts let 64-bit values written under a lock be read
+ * without it and without tearing on 32-bit CPUs: the count is odd
+ * while the (single, locked) writer updates the value, and readers
+ * retry until they see the same even count on both sides of their
+ * read.
+ */
+static void seq_write(atomic_t *seq, u64_t *val, u64_t new_val)
 {
-	sys_dnode_t *t = sys_dlist_peek_head(&timeout_list);
+	(void)atomic_inc(seq);
+	compiler_barrier();
+	*val = new_val;
+	compiler_barrier();
+	(void)atomic_inc(seq);
+}
+
+static u64_t seq_read(const atomic_t *seq, const u64_t *val)
+{
+	atomic_val_t start;
+	u64_t ret;
+
+	do {
+		start = atomic_get(seq);
+		compiler_barrier();
+		ret = *val;
+		compiler_barrier();
+	} while ((start & 1) != 0 || start != atomic_get(seq));
+
+	return ret;
+}
+
+static atomic_t curr_tick_seq;
+
+/* Reads curr_tick from under a per-CPU queue lock */
+static u64_t get_curr_tick(void)
+{
+	return seq_read(&curr_tick_seq, &curr_tick);
+}
+#else
+/* The queue lock is timeout_lock itself */
+#define get_curr_tick() curr_tick
+#endif
+
+#ifdef CONFIG_TIMEOUT_QUEUE_SCALABLE
+
+struct timeout_q {
+	struct rbtree tree;
+
+	/* Cached leftmost node of the tree, keeps first() O(1) */
+	struct _timeout *min;
+
+	u32_t next_order_key;
+
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	struct k_spinlock lock;
+
+	/* Tick by which the queue must be announced (the expiry of
+	 * min, or later with CONFIG_TIMEOUT_SLACK), or UINT64_MAX when
+	 * empty.  Written under the queue lock, but other CPUs read it
+	 * through next_seq to find the earliest deadline of all queues.
+	 */
+	u64_t next_expiry;
+	atomic_t next_seq;
+
+	/* Expiry of the timeout whose callback is running, which new
+	 * timeouts added from that callback are relative to
+	 */
+	u64_t announce_tick;
+	bool announcing;
+#endif
+};
+
+/* Timeouts are keyed by absolute expiration tick in a red/black
+ * tree.  Equal expirations are broken by insertion order so that they
+ * fire FIFO, exactly as with the delta list.  The order key compare
+ * is wraparound-safe as long as fewer than 2^31 timeouts are queued.
+ */
+static bool timeout_lessthan(struct rbnode *a, struct rbnode *b)
+{
+	struct _timeout *ta = CONTAINER_OF(a, struct _timeout, node);
+	struct _timeout *tb = CONTAINER_OF(b, struct _timeout, node);
+
+	if (ta->expiry != tb->expiry) {
+		return ta->expiry < tb->expiry;
+	}
+
+	return (s32_t)(ta->order_key - tb->order_key) < 0;
+}
+
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+static struct timeout_q timeout_qs[CONFIG_MP_NUM_CPUS] = {
+	[0 ... (CONFIG_MP_NUM_CPUS - 1)] = {
+		.tree = {
+			.lessthan_fn = timeout_lessthan,
+		},
+		.next_expiry = UINT64_MAX,
+	},
+};
+#else
+static struct timeout_q timeout_q = {
+	.tree = {
+		.lessthan_fn = timeout_lessthan,
+	},
+};
+#endif
+
+static struct _timeout *first(struct timeout_q *q)
+{
+	return q->min;
+}
+
+#ifdef CONFIG_TIMEOUT_SLACK
+/* Latest tick at which the queue can be announced without running
+ * any of its timeouts later than its slack allows, i.e. the smallest
+ * expiry + slack.  Only a timeout expiring before the best deadline
+ * found so far can lower it, so the walk stops at the first one that
+ * does not.
+ */
+static u64_t queue_deadline(struct timeout_q *q)
+{
+	struct rbnode *n;
+	u64_t deadline;
+
+	if (q->min == NULL) {
+		return UINT64_MAX;
+	}
+
+	deadline = q->min->expiry + q->min->slack;
+	if (q->min->slack == 0U) {
+		return deadline;
+	}
+
+	RB_FOR_EACH(&q->tree, n) {
+		struct _timeout *t = CONTAINER_OF(n, struct _timeout, node);
+
+		if (t->expiry >= deadline) {
+			break;
+		}
+		deadline = MIN(deadline, t->expiry + t->slack);
+	}
+
+	return deadline;
+}
+#else
+static u64_t queue_deadline(struct timeout_q *q)
+{
+	return q->min == NULL ? UINT64_MAX : q->min->expiry;
+}
+#endif
+
+#ifndef CONFIG_TIMEOUT_QUEUE_PER_CPU
+/* Ticks from curr_tick until the first timeout expires */
+static k_ticks_t first_dticks(struct timeout_q *q)
+{
+	return (k_ticks_t)(q->min->expiry - curr_tick);
+}
+
+/* Ticks from curr_tick until the queue must be announced */
+static k_ticks_t deadline_dticks(struct timeout_q *q)
+{
+	return (k_ticks_t)(queue_deadline(q) - curr_tick);
+}
+#endif
+
+static void set_first(struct timeout_q *q, struct _timeout *t)
+{
+	q->min = t;
+
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	seq_write(&q->next_seq, &q->next_expiry, queue_deadline(q));
+#endif
+}
+
+/* The tick that new timeouts on this queue are relative to */
+static u64_t queue_now(struct timeout_q *q)
+{
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	if (q->announcing) {
+		return q->announce_tick;
+	}
+#else
+	ARG_UNUSED(q);
+#endif
+	return get_curr_tick() + elapsed();
+}
+
+/* Queues a timeout whose expiry is already set */
+static void queue_timeout(struct timeout_q *q, struct _timeout *to)
+{
+	to->order_key = q->next_order_key++;
+	rb_insert(&q->tree, &to->node);
+
+	if (q->min == NULL || timeout_lessthan(&to->node, &q->min->node)) {
+		set_first(q, to);
+	} else if (IS_ENABLED(CONFIG_TIMEOUT_SLACK)) {
+		/* A later timeout with less slack can still bring the
+		 * deadline in
+		 */
+		set_first(q, q->min);
+	}
+}
+
+static void insert_timeout(struct timeout_q *q, struct _timeout *to,
+			   k_ticks_t ticks)
+{
+	to->expiry = queue_now(q) + ticks;
+	queue_timeout(q, to);
+}
+
+static void remove_timeout(struct timeout_q *q, struct _timeout *t)
+{
+	rb_remove(&q->tree, &t->node);
+	t->expiry = 0U;
+
+	if (t == q->min) {
+		struct rbnode *n = rb_get_min(&q->tree);
+
+		set_first(q, n == NULL ? NULL
+			  : CONTAINER_OF(n, struct _timeout, node));
+	} else if (IS_ENABLED(CONFIG_TIMEOUT_SLACK)) {
+		set_first(q, q->min);
+	}
+}
+
+/* True if queueing "to" may have brought the queue's deadline in */
+static bool sets_deadline(struct timeout_q *q, struct _timeout *to)
+{
+#ifdef CONFIG_TIMEOUT_SLACK
+	return to->expiry + to->slack <= queue_deadline(q);
+#else
+	return to == first(q);
+#endif
+}
+
+#ifndef CONFIG_TIMEOUT_QUEUE_PER_CPU
+/* Accounts for "ticks" passing after the first timeout was popped */
+static void advance_first(struct timeout_q *q, s32_t ticks)
+{
+	ARG_UNUSED(q);
+	ARG_UNUSED(ticks);
+}
+#endif
+
+/* must be locked */
+static k_ticks_t timeout_rem(struct timeout_q *q, struct _timeout *timeout)
+{
+	if (z_is_inactive_timeout(timeout)) {
+		return 0;
+	}
+
+	return (k_ticks_t)(timeout->expiry - queue_now(q));
+}
+
+#else /* CONFIG_TIMEOUT_QUEUE_DUMB */
+
+struct timeout_q {
+	sys_dlist_t list;
+};
+
+static struct timeout_q timeout_q = {
+	.list = SYS_DLIST_STATIC_INIT(&timeout_q.list),
+};
+
+static struct _timeout *first(struct timeout_q *q)
+{
+	sys_dnode_t *t = sys_dlist_peek_head(&q->list);
 
 	return t == NULL ? NULL : CONTAINER_OF(t, struct _timeout, node);
 }
 
-static struct _timeout *next(struct _timeout *t)
+static struct _timeout *next(struct timeout_q *q, struct _timeout *t)
 {
-	sys_dnode_t *n = sys_dlist_peek_next(&timeout_list, &t->node);
+	sys_dnode_t *n = sys_dlist_peek_next(&q->list, &t->node);
 
 	return n == NULL ? NULL : CONTAINER_OF(n, struct _timeout, node);
 }
 
-static void remove_timeout(struct _timeout *t)
+static k_ticks_t first_dticks(struct timeout_q *q)
+{
+	return first(q)->dticks;
+}
+
+#ifdef CONFIG_TIMEOUT_SLACK
+/* Ticks from curr_tick until the queue must be announced: the
+ * smallest expiry + slack, see the scalable queue_deadline()
+ */
+static k_ticks_t deadline_dticks(struct timeout_q *q)
+{
+	struct _timeout *t = first(q);
+	s64_t ticks = t->dticks;
+	s64_t deadline = ticks + t->slack;
+
+	if (t->slack == 0U) {
+		return (k_ticks_t)ticks;
+	}
+
+	while ((t = next(q, t)) != NULL) {
+		ticks += t->dticks;
+		if (ticks >= deadline) {
+			break;
+		}
+		deadline = MIN(deadline, ticks + t->slack);
+	}
+
+	return (k_ticks_t)MIN(deadline, INT_MAX);
+}
+#else
+#define deadline_dticks(q) first_dticks(q)
+#endif
+
+static void insert_timeout(struct timeout_q *q, struct _timeout *to,
+			   k_ticks_t ticks)
+{
+	struct _timeout *t;
+
+	to->dticks = ticks + elapsed();
+	for (t = first(q); t != NULL; t = next(q, t)) {
+		__ASSERT(t->dticks >= 0, "");
+
+		if (t->dticks > to->dticks) {
+			t->dticks -= to->dticks;
+			sys_dlist_insert(&t->node, &to->node);
+			break;
+		}
+		to->dticks -= t->dticks;
+	}
+
+	if (t == NULL) {
+		sys_dlist_append(&q->list, &to->node);
+	}
+}
+
+static void remove_timeout(struct timeout_q *q, struct _timeout *t)
 {
-	if (next(t) != NULL) {
-		next(t)->dticks += t->dticks;
+	if (next(q, t) != NULL) {
+		next(q, t)->dticks += t->dticks;
 	}
 
 	sys_dlist_remove(&t->node);
 }
 
-static s32_t elapsed(void)
+static void advance_first(struct timeout_q *q, s32_t ticks)
 {
-	return announce_remaining == 0 ? z_clock_elapsed() : 0;
+	if (first(q) != NULL) {
+		first(q)->dticks -= ticks;
+	}
 }
 
+/* must be locked */
+static k_ticks_t timeout_rem(struct timeout_q *q, struct _timeout *timeout)
+{
+	k_ticks_t ticks = 0;
+
+	if (z_is_inactive_timeout(timeout)) {
+		return 0;
+	}
+
+	for (struct _timeout *t = first(q); t != NULL; t = next(q, t)) {
+		ticks += t->dticks;
+		if (timeout == t) {
+			break;
+		}
+	}
+
+	return ticks - elapsed();
+}
+
+/* True if queueing "to" may have brought the queue's deadline in */
+static bool sets_deadline(struct timeout_q *q, struct _timeout *to)
+{
+#ifdef CONFIG_TIMEOUT_SLACK
+	s64_t to_deadline = (s64_t)timeout_rem(q, to) + elapsed() + to->slack;
+
+	return to_deadline <= deadline_dticks(q);
+#else
+	return to == first(q);
+#endif
+}
+
+#endif /* CONFIG_TIMEOUT_QUEUE_SCALABLE */
+
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+
+#define QUEUE_LOCK(q) (&(q)->lock)
+
+static struct timeout_q *queue_of(struct _timeout *t)
+{
+	return &timeout_qs[t->cpu];
+}
+
+/* Locks and returns the current CPU's queue.  Interrupts are masked
+ * before the CPU is sampled so that we cannot be migrated in between;
+ * the returned key restores the state from before that masking.
+ */
+static struct timeout_q *lock_local_queue(k_spinlock_key_t *key)
+{
+	unsigned int irq_key = arch_irq_lock();
+	struct timeout_q *q = &timeout_qs[arch_curr_cpu()->id];
+
+	*key = k_spin_lock(&q->lock);
+	key->key = irq_key;
+	return q;
+}
+
+#else
+
+#define QUEUE_LOCK(q) (&timeout_lock)
+
+static struct timeout_q *queue_of(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+	return &timeout_q;
+}
+
+static struct timeout_q *lock_local_queue(k_spinlock_key_t *key)
+{
+	*key = k_spin_lock(&timeout_lock);
+	return &timeout_q;
+}
+
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
+
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+static u64_t next_expiry(struct timeout_q *q)
+{
+	return seq_read(&q->next_seq, &q->next_expiry);
+}
+
+/* True if the queue's deadline comes before every other CPU's, so
+ * that the system timer has to be brought in for it.  Deadlines at or
+ * before curr_tick belong to queues being announced, which reprogram
+ * the timer once done.
+ */
+static bool is_global_first(struct timeout_q *q)
+{
+	u64_t now = get_curr_tick();
+	u64_t deadline = next_expiry(q);
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		u64_t next = next_expiry(&timeout_qs[i]);
+
+		if (&timeout_qs[i] != q && next > now && next <= deadline) {
+			return false;
+		}
+	}
+
+	return true;
+}
+#endif
+
+/* must hold timeout_lock */
 static s32_t next_timeout(void)
 {
-	struct _timeout *to = first();
 	s32_t ticks_elapsed = elapsed();
-	s32_t ret = to == NULL ? MAX_WAIT : MAX(0, to->dticks - ticks_elapsed);
+	s32_t ret = MAX_WAIT;
+
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	u64_t next = UINT64_MAX;
+
+	/* Expirations at or before curr_tick have already been handed
+	 * to their CPU by z_clock_announce(), which will reprogram the
+	 * timer once it has run them.
+	 */
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		u64_t q_next = next_expiry(&timeout_qs[i]);
+
+		if (q_next > curr_tick) {
+			next = MIN(next, q_next);
+		}
+	}
+
+	if (next != UINT64_MAX) {
+		ret = (s32_t)MIN(MAX(0, (s64_t)(next - curr_tick)
+				     - ticks_elapsed), INT_MAX);
+	}
+#else
+	if (first(&timeout_q) != NULL) {
+		ret = (s32_t)MIN(MAX(0, deadline_dticks(&timeout_q)
+				     - ticks_elapsed), INT_MAX);
+	}
+#endif
 
 #ifdef CONFIG_TIMESLICING
 	if (_current_cpu->slice_ticks && _current_cpu->slice_ticks < ret) {
@@ -96,46 +554,45 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 	k_ticks_t ticks = timeout.ticks + 1;
 
 	if (IS_ENABLED(CONFIG_TIMEOUT_64BIT) && Z_TICK_ABS(ticks) >= 0) {
-		ticks = Z_TICK_ABS(ticks) - (curr_tick + elapsed());
+		ticks = Z_TICK_ABS(ticks) - (get_curr_tick() + elapsed());
 	}
 #endif
 
-	__ASSERT(!sys_dnode_is_linked(&to->node), "");
+	__ASSERT(z_is_inactive_timeout(to), "");
 	to->fn = fn;
 	ticks = MAX(1, ticks);
 
-	LOCKED(&timeout_lock) {
-		struct _timeout *t;
+	k_spinlock_key_t key;
+	struct timeout_q *q = lock_local_queue(&key);
 
-		to->dticks = ticks + elapsed();
-		for (t = first(); t != NULL; t = next(t)) {
-			__ASSERT(t->dticks >= 0, "");
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	to->cpu = arch_curr_cpu()->id;
+#endif
+	insert_timeout(q, to, ticks);
 
-			if (t->dticks > to->dticks) {
-				t->dticks -= to->dticks;
-				sys_dlist_insert(&t->node, &to->node);
-				break;
+	if (sets_deadline(q, to)) {
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+		if (is_global_first(q)) {
+			LOCKED(&timeout_lock) {
+				z_clock_set_timeout(next_timeout(), false);
 			}
-			to->dticks -= t->dticks;
-		}
-
-		if (t == NULL) {
-			sys_dlist_append(&timeout_list, &to->node);
-		}
-
-		if (to == first()) {
-			z_clock_set_timeout(next_timeout(), false);
 		}
+#else
+		z_clock_set_timeout(next_timeout(), false);
+#endif
 	}
+
+	k_spin_unlock(QUEUE_LOCK(q), key);
 }
 
 int z_abort_timeout(struct _timeout *to)
 {
+	struct timeout_q *q = queue_of(to);
 	int ret = -EINVAL;
 
-	LOCKED(&timeout_lock) {
-		if (sys_dnode_is_linked(&to->node)) {
-			remove_timeout(to);
+	LOCKED(QUEUE_LOCK(q)) {
+		if (!z_is_inactive_timeout(to)) {
+			remove_timeout(q, to);
 			ret = 0;
 		}
 	}
@@ -143,31 +600,27 @@ int z_abort_timeout(struct _timeout *to)
 	return ret;
 }
 
-/* must be locked */
-static k_ticks_t timeout_rem(struct _timeout *timeout)
+#ifdef CONFIG_TIMEOUT_SLACK
+void z_timeout_slack_set(struct _timeout *to, k_timeout_t slack)
 {
-	k_ticks_t ticks = 0;
-
-	if (z_is_inactive_timeout(timeout)) {
-		return 0;
-	}
+	__ASSERT(!K_TIMEOUT_EQ(slack, K_FOREVER), "slack must be bounded");
 
-	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
-		ticks += t->dticks;
-		if (timeout == t) {
-			break;
-		}
-	}
-
-	return ticks - elapsed();
+#ifdef CONFIG_LEGACY_TIMEOUT_API
+	to->slack = k_ms_to_ticks_ceil32(slack);
+#else
+	__ASSERT(Z_TICK_ABS(slack.ticks) < 0, "slack must be relative");
+	to->slack = (u32_t)MAX(slack.ticks, 0);
+#endif
 }
+#endif
 
 k_ticks_t z_timeout_remaining(struct _timeout *timeout)
 {
+	struct timeout_q *q = queue_of(timeout);
 	k_ticks_t ticks = 0;
 
-	LOCKED(&timeout_lock) {
-		ticks = timeout_rem(timeout);
+	LOCKED(QUEUE_LOCK(q)) {
+		ticks = timeout_rem(q, timeout);
 	}
 
 	return ticks;
@@ -175,10 +628,11 @@ k_ticks_t z_timeout_remaining(struct _timeout *timeout)
 
 k_ticks_t z_timeout_expires(struct _timeout *timeout)
 {
+	struct timeout_q *q = queue_of(timeout);
 	k_ticks_t ticks = 0;
 
-	LOCKED(&timeout_lock) {
-		ticks = curr_tick + timeout_rem(timeout);
+	LOCKED(QUEUE_LOCK(q)) {
+		ticks = get_curr_tick() + timeout_rem(q, timeout);
 	}
 
 	return ticks;
@@ -217,6 +671,93 @@ void z_set_timeout_expiry(s32_t ticks, bool idle)
 	}
 }
 
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+
+/* Runs every timeout on this queue that expires at or before
+ * curr_tick.  The queue is only ever announced by its own CPU (bar the
+ * no-IPI fallback in z_clock_announce()), so callbacks see the same
+ * CPU that armed them.
+ */
+static void announce_queue(struct timeout_q *q)
+{
+	k_spinlock_key_t key = k_spin_lock(&q->lock);
+
+	/* A nested announce (e.g. the IPI landing while a callback
+	 * runs with the lock dropped) leaves the work to the outer
+	 * loop, which re-reads curr_tick on every pass
+	 */
+	if (q->announcing) {
+		k_spin_unlock(&q->lock, key);
+		return;
+	}
+
+	q->announcing = true;
+
+	while (first(q) != NULL && first(q)->expiry <= get_curr_tick()) {
+		struct _timeout *t = first(q);
+
+		q->announce_tick = t->expiry;
+		remove_timeout(q, t);
+
+		k_spin_unlock(&q->lock, key);
+		t->fn(t);
+		key = k_spin_lock(&q->lock);
+	}
+
+	q->announcing = false;
+	k_spin_unlock(&q->lock, key);
+}
+
+void z_timeout_ipi(void)
+{
+	announce_queue(&timeout_qs[arch_curr_cpu()->id]);
+
+	LOCKED(&timeout_lock) {
+		z_clock_set_timeout(next_timeout(), false);
+	}
+}
+
+void z_clock_announce(s32_t ticks)
+{
+#ifdef CONFIG_TIMESLICING
+	z_time_slice(ticks);
+#endif
+
+	int id = arch_curr_cpu()->id;
+	bool remote = false;
+
+	LOCKED(&timeout_lock) {
+		seq_write(&curr_tick_seq, &curr_tick, curr_tick + ticks);
+
+		for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+			if (i != id &&
+			    next_expiry(&timeout_qs[i]) <= curr_tick) {
+				remote = true;
+			}
+		}
+	}
+
+	announce_queue(&timeout_qs[id]);
+
+	if (remote) {
+#ifdef CONFIG_SCHED_IPI_SUPPORTED
+		arch_sched_ipi();
+#else
+		for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+			if (i != id) {
+				announce_queue(&timeout_qs[i]);
+			}
+		}
+#endif
+	}
+
+	LOCKED(&timeout_lock) {
+		z_clock_set_timeout(next_timeout(), false);
+	}
+}
+
+#else
+
 void z_clock_announce(s32_t ticks)
 {
 #ifdef CONFIG_TIMESLICING
@@ -227,23 +768,22 @@ void z_clock_announce(s32_t ticks)
 
 	announce_remaining = ticks;
 
-	while (first() != NULL && first()->dticks <= announce_remaining) {
-		struct _timeout *t = first();
-		int dt = t->dticks;
+	while (first(&timeout_q) != NULL &&
+	       first_dticks(&timeout_q) <= announce_remaining) {
+		struct _timeout *t = first(&timeout_q);
+		int dt = first_dticks(&timeout_q);
 
 		curr_tick += dt;
 		announce_remaining -= dt;
-		t->dticks = 0;
-		remove_timeout(t);
+		remove_timeout(&timeout_q, t);
+		advance_first(&timeout_q, dt);
 
 		k_spin_unlock(&timeout_lock, key);
 		t->fn(t);
 		key = k_spin_lock(&timeout_lock);
 	}
 
-	if (first() != NULL) {
-		first()->dticks -= announce_remaining;
-	}
+	advance_first(&timeout_q, announce_remaining);
 
 	curr_tick += announce_remaining;
 	announce_remaining = 0;
@@ -253,6 +793,8 @@ void z_clock_announce(s32_t ticks)
 	k_spin_unlock(&timeout_lock, key);
 }
 
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
+
 s64_t z_tick_get(void)
 {
 	u64_t t = 0U;
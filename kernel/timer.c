@@ -173,6 +173,25 @@ void z_impl_k_timer_stop(struct k_timer *timer)
 	}
 }
 
+void z_impl_k_timer_slack_set(struct k_timer *timer, k_timeout_t slack)
+{
+	z_timeout_slack_set(&timer->timeout, slack);
+}
+
+#ifdef CONFIG_USERSPACE
+static inline void z_vrfy_k_timer_slack_set(struct k_timer *timer,
+					    k_timeout_t slack)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(timer, K_OBJ_TIMER));
+	Z_OOPS(Z_SYSCALL_VERIFY(!K_TIMEOUT_EQ(slack, K_FOREVER)));
+#ifndef CONFIG_LEGACY_TIMEOUT_API
+	Z_OOPS(Z_SYSCALL_VERIFY(Z_TICK_ABS(slack.ticks) < 0));
+#endif
+	z_impl_k_timer_slack_set(timer, slack);
+}
+#include <syscalls/k_timer_slack_set_mrsh.c>
+#endif
+
 #ifdef CONFIG_USERSPACE
 static inline void z_vrfy_k_timer_stop(struct k_timer *timer)
 {
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <kernel_structs.h>
+#include <kernel_internal.h>
+#include <sys/atomic.h>
+#include <sys/util.h>
+
+/* Thread runtime statistics.  Each CPU remembers which thread it last
+ * switched in and when: that thread is charged for the time up to the
+ * next switch.
+ *
+ * The switch path takes no lock.  A CPU only writes its own
+ * usage_thread and usage_start, and the statistics of the threads it
+ * switches out and in, which no other CPU can be running at that
+ * point.  It bumps its usage_seq around those writes so that readers
+ * can detect, and retry, a read that raced with them.
+ */
+
+static unsigned int latency_bucket(u32_t cycles)
+{
+	u32_t us = k_cyc_to_us_floor32(cycles);
+
+	if (us == 0U) {
+		return 0;
+	}
+
+	return MIN(32 - __builtin_clz(us), K_THREAD_LATENCY_BUCKETS - 1);
+}
+
+void z_thread_mark_switched_in(void)
+{
+	unsigned int key = arch_irq_lock();
+	struct _cpu *cpu = _current_cpu;
+	struct k_thread *thread = cpu->current;
+	u32_t now;
+
+	if (cpu->usage_thread == thread) {
+		/* rescheduled the thread that was already running */
+		arch_irq_unlock(key);
+		return;
+	}
+
+	(void)atomic_inc(&cpu->usage_seq);
+	compiler_barrier();
+
+	now = k_cycle_get_32();
+	if (cpu->usage_thread != NULL) {
+		cpu->usage_thread->rt_stats.execution_cycles +=
+			now - cpu->usage_start;
+	}
+	cpu->usage_thread = thread;
+	cpu->usage_start = now;
+
+	thread->rt_stats.switches++;
+	if (thread->ready_stamp != 0U) {
+		thread->rt_stats.latency_hist[
+			latency_bucket(now - thread->ready_stamp)]++;
+		thread->ready_stamp = 0U;
+	}
+
+	compiler_barrier();
+	(void)atomic_inc(&cpu->usage_seq);
+
+	arch_irq_unlock(key);
+}
+
+/* Samples every CPU's usage_seq, waiting out any update in progress */
+static void usage_seq_begin(atomic_val_t *seqs)
+{
+	for (unsigned int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		do {
+			seqs[i] = atomic_get(&_kernel.cpus[i].usage_seq);
+		} while ((seqs[i] & 1) != 0);
+	}
+
+	compiler_barrier();
+}
+
+/* True if no CPU updated any statistics since usage_seq_begin() */
+static bool usage_seq_end(const atomic_val_t *seqs)
+{
+	compiler_barrier();
+	for (unsigned int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		if (atomic_get(&_kernel.cpus[i].usage_seq) != seqs[i]) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+int k_thread_runtime_stats_get(k_tid_t thread,
+			       struct k_thread_runtime_stats *stats)
+{
+	atomic_val_t seqs[CONFIG_MP_NUM_CPUS];
+	u32_t now;
+
+	if ((thread == NULL) || (stats == NULL)) {
+		return -EINVAL;
+	}
+
+	do {
+		usage_seq_begin(seqs);
+
+		now = k_cycle_get_32();
+		*stats = thread->rt_stats;
+
+		/* add the current run, if any */
+		for (unsigned int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+			if (_kernel.cpus[i].usage_thread == thread) {
+				stats->execution_cycles +=
+					now - _kernel.cpus[i].usage_start;
+			}
+		}
+	} while (!usage_seq_end(seqs));
+
+	return 0;
+}
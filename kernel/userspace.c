@@ -47,7 +47,7 @@ LOG_MODULE_DECLARE(os);
  * not.
  */
 #ifdef CONFIG_DYNAMIC_OBJECTS
-static struct k_spinlock lists_lock;       /* kobj rbtree/dlist */
+static struct k_spinlock lists_lock;       /* kobj hash table */
 static struct k_spinlock objfree_lock;     /* k_object_free */
 #endif
 static struct k_spinlock obj_lock;         /* kobj struct data */
@@ -112,8 +112,7 @@ u8_t *z_priv_stack_find(k_thread_stack_t *stack)
 #ifdef CONFIG_DYNAMIC_OBJECTS
 struct dyn_obj {
 	struct z_object kobj;
-	sys_dnode_t obj_list;
-	struct rbnode node; /* must be immediately before data member */
+	sys_snode_t node;
 	u8_t data[]; /* The object itself */
 };
 
@@ -121,26 +120,15 @@ extern struct z_object *z_object_gperf_find(void *obj);
 extern void z_object_gperf_wordlist_foreach(_wordlist_cb_func_t func,
 					     void *context);
 
-static bool node_lessthan(struct rbnode *a, struct rbnode *b);
+#define OBJ_HASH_SIZE BIT(CONFIG_DYNAMIC_OBJECTS_HASH_BITS)
 
 /*
- * Red/black tree of allocated kernel objects, for reasonably fast lookups
- * based on object pointer values.
- */
-static struct rbtree obj_rb_tree = {
-	.lessthan_fn = node_lessthan
-};
-
-/*
- * Linked list of allocated kernel objects, for iteration over all allocated
- * objects (and potentially deleting them during iteration).
- */
-static sys_dlist_t obj_list = SYS_DLIST_STATIC_INIT(&obj_list);
-
-/*
- * TODO: Write some hash table code that will replace both obj_rb_tree
- * and obj_list.
+ * Hash table of allocated kernel objects, chained by bucket, for fast
+ * lookups based on object pointer values and for iteration over all
+ * allocated objects (and potentially deleting them during iteration).
+ * Zeroed lists are empty, so it needs no initialization.
  */
+static sys_slist_t obj_hash[OBJ_HASH_SIZE];
 
 static size_t obj_size_get(enum k_objects otype)
 {
@@ -156,39 +144,43 @@ static size_t obj_size_get(enum k_objects otype)
 	return ret;
 }
 
-static bool node_lessthan(struct rbnode *a, struct rbnode *b)
+static sys_slist_t *obj_hash_bucket(void *obj)
 {
-	return a < b;
-}
+	/* Fibonacci hashing of the object address. Objects are at
+	 * least word aligned, so the low bits carry no information.
+	 */
+	u32_t hash = (u32_t)((uintptr_t)obj >> 2) * 2654435769U;
 
-static inline struct dyn_obj *node_to_dyn_obj(struct rbnode *node)
-{
-	return CONTAINER_OF(node, struct dyn_obj, node);
+	return &obj_hash[hash >> (32 - CONFIG_DYNAMIC_OBJECTS_HASH_BITS)];
 }
 
 static struct dyn_obj *dyn_object_find(void *obj)
 {
-	struct rbnode *node;
-	struct dyn_obj *ret;
+	struct dyn_obj *dyn_obj;
+	struct dyn_obj *ret = NULL;
 
-	/* For any dynamically allocated kernel object, the object
-	 * pointer is just a member of the conatining struct dyn_obj,
-	 * so just a little arithmetic is necessary to locate the
-	 * corresponding struct rbnode
+	/* Only the bucket's entries are dereferenced, never obj, which
+	 * may be any pointer passed by user mode
 	 */
-	node = (struct rbnode *)((char *)obj - sizeof(struct rbnode));
-
 	k_spinlock_key_t key = k_spin_lock(&lists_lock);
-	if (rb_contains(&obj_rb_tree, node)) {
-		ret = node_to_dyn_obj(node);
-	} else {
-		ret = NULL;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(obj_hash_bucket(obj), dyn_obj, node) {
+		if (dyn_obj->kobj.name == obj) {
+			ret = dyn_obj;
+			break;
+		}
 	}
 	k_spin_unlock(&lists_lock, key);
 
 	return ret;
 }
 
+static void dyn_object_remove(struct dyn_obj *dyn_obj)
+{
+	sys_slist_find_and_remove(obj_hash_bucket(dyn_obj->kobj.name),
+				  &dyn_obj->node);
+}
+
 /**
  * @internal
  *
@@ -292,8 +284,7 @@ void *z_impl_k_object_alloc(enum k_objects otype)
 
 	k_spinlock_key_t key = k_spin_lock(&lists_lock);
 
-	rb_insert(&obj_rb_tree, &dyn_obj->node);
-	sys_dlist_append(&obj_list, &dyn_obj->obj_list);
+	sys_slist_prepend(obj_hash_bucket(dyn_obj->kobj.name), &dyn_obj->node);
 	k_spin_unlock(&lists_lock, key);
 
 	return dyn_obj->kobj.name;
@@ -312,8 +303,10 @@ void k_object_free(void *obj)
 
 	dyn_obj = dyn_object_find(obj);
 	if (dyn_obj != NULL) {
-		rb_remove(&obj_rb_tree, &dyn_obj->node);
-		sys_dlist_remove(&dyn_obj->obj_list);
+		k_spinlock_key_t lists_key = k_spin_lock(&lists_lock);
+
+		dyn_object_remove(dyn_obj);
+		k_spin_unlock(&lists_lock, lists_key);
 
 		if (dyn_obj->kobj.type == K_OBJ_THREAD) {
 			thread_idx_free(dyn_obj->kobj.data.thread_id);
@@ -352,8 +345,11 @@ void z_object_wordlist_foreach(_wordlist_cb_func_t func, void *context)
 
 	k_spinlock_key_t key = k_spin_lock(&lists_lock);
 
-	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&obj_list, obj, next, obj_list) {
-		func(&obj->kobj, context);
+	for (int i = 0; i < OBJ_HASH_SIZE; i++) {
+		SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&obj_hash[i], obj, next,
+						  node) {
+			func(&obj->kobj, context);
+		}
 	}
 	k_spin_unlock(&lists_lock, key);
 }
@@ -412,8 +408,7 @@ static void unref_check(struct z_object *ko, uintptr_t index)
 		break;
 	}
 
-	rb_remove(&obj_rb_tree, &dyn_obj->node);
-	sys_dlist_remove(&dyn_obj->obj_list);
+	dyn_object_remove(dyn_obj);
 	k_free(dyn_obj);
 out:
 #endif
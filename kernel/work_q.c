@@ -36,6 +36,110 @@ void k_work_q_start(struct k_work_q *work_q, k_thread_stack_t *stack,
 	k_thread_name_set(&work_q->thread, WORKQUEUE_THREAD_NAME);
 }
 
+/* Claims a work item for a pool worker, unless another worker is
+ * running it already, in which case that worker is asked to run it
+ * again when it is done.  Returns true if the caller should run it.
+ */
+static bool pool_claim(struct k_work_q_pool *pool,
+		       struct k_work_q_worker *self, struct k_work *work)
+{
+	k_spinlock_key_t key = k_spin_lock(&pool->lock);
+
+	for (int i = 0; i < pool->num_workers; i++) {
+		if (pool->workers[i].current == work) {
+			pool->workers[i].rerun = true;
+			k_spin_unlock(&pool->lock, key);
+			return false;
+		}
+	}
+
+	self->current = work;
+	k_spin_unlock(&pool->lock, key);
+
+	return true;
+}
+
+/* Releases the current work item, returns true if it has to be run
+ * again first
+ */
+static bool pool_release(struct k_work_q_pool *pool,
+			 struct k_work_q_worker *self)
+{
+	k_spinlock_key_t key = k_spin_lock(&pool->lock);
+	bool rerun = self->rerun;
+
+	if (rerun) {
+		self->rerun = false;
+	} else {
+		self->current = NULL;
+	}
+	k_spin_unlock(&pool->lock, key);
+
+	return rerun;
+}
+
+static void work_q_pool_main(void *pool_ptr, void *worker_ptr, void *p3)
+{
+	struct k_work_q_pool *pool = pool_ptr;
+	struct k_work_q_worker *self = worker_ptr;
+
+	ARG_UNUSED(p3);
+
+	while (true) {
+		struct k_work *work;
+
+		work = k_queue_get(&pool->work_q.queue, K_FOREVER);
+		if (work == NULL || !pool_claim(pool, self, work)) {
+			continue;
+		}
+
+		do {
+			/* Reset pending state so it can be resubmitted by
+			 * handler
+			 */
+			if (atomic_test_and_clear_bit(work->flags,
+						      K_WORK_STATE_PENDING)) {
+				work->handler(work);
+			}
+		} while (pool_release(pool, self));
+
+		/* Make sure we don't hog up the CPU if the FIFO never (or
+		 * very rarely) gets empty.
+		 */
+		k_yield();
+	}
+}
+
+void k_work_q_pool_start(struct k_work_q_pool *pool, int prio,
+			 u32_t options)
+{
+	k_queue_init(&pool->work_q.queue);
+
+	for (int i = 0; i < pool->num_workers; i++) {
+		struct k_work_q_worker *w = &pool->workers[i];
+		k_thread_stack_t *stack = (k_thread_stack_t *)
+			((char *)pool->stacks +
+			 i * K_THREAD_STACK_LEN(pool->stack_size));
+
+		w->current = NULL;
+		w->rerun = false;
+		(void)k_thread_create(&w->thread, stack, pool->stack_size,
+				      work_q_pool_main, pool, w, NULL,
+				      prio, 0, K_FOREVER);
+		k_thread_name_set(&w->thread, WORKQUEUE_THREAD_NAME);
+#ifdef CONFIG_SCHED_CPU_MASK
+		if ((options & K_WORK_Q_POOL_PIN_CPUS) != 0U) {
+			(void)k_thread_cpu_mask_clear(&w->thread);
+			(void)k_thread_cpu_mask_enable(&w->thread,
+						       i % CONFIG_MP_NUM_CPUS);
+		}
+#else
+		ARG_UNUSED(options);
+#endif
+		k_thread_start(&w->thread);
+	}
+}
+
 #ifdef CONFIG_SYS_CLOCK_EXISTS
 static void work_timeout(struct _timeout *t)
 {
@@ -53,6 +157,11 @@ void k_delayed_work_init(struct k_delayed_work *work, k_work_handler_t handler)
 	work->work_q = NULL;
 }
 
+void k_delayed_work_slack_set(struct k_delayed_work *work, k_timeout_t slack)
+{
+	z_timeout_slack_set(&work->timeout, slack);
+}
+
 static int work_cancel(struct k_delayed_work *work)
 {
 	CHECKIF(work->work_q == NULL) {
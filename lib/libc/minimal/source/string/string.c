@@ -9,6 +9,28 @@
 #include <string.h>
 #include <stdint.h>
 #include <sys/types.h>
+#include <toolchain.h>
+
+#ifndef CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SIZE
+/*
+ * The speed optimized routines below work a word at a time. Words are
+ * only read at aligned addresses, so reading a whole word when only some
+ * of its bytes belong to the buffer never crosses into another page or
+ * memory protection region.
+ */
+typedef mem_word_t __may_alias word_t;
+
+#define WORD_SIZE sizeof(word_t)
+#define WORD_MASK (WORD_SIZE - 1)
+#define IS_WORD_ALIGNED(p) (((uintptr_t)(p) & WORD_MASK) == 0)
+
+/* 0x01 and 0x80 repeated in every byte of a word */
+#define ONES ((word_t)-1 / 0xFF)
+#define HIGHS (ONES << 7)
+
+/* Non-zero if any byte of the word is zero */
+#define HAS_ZERO(w) (((w) - ONES) & ~(w) & HIGHS)
+#endif
 
 /**
  *
@@ -106,6 +128,7 @@ char *strrchr(const char *s, int c)
 
 size_t strlen(const char *s)
 {
+#ifdef CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SIZE
 	size_t n = 0;
 
 	while (*s != '\0') {
@@ -114,6 +137,30 @@ size_t strlen(const char *s)
 	}
 
 	return n;
+#else
+	const char *p = s;
+	const word_t *w;
+
+	while (!IS_WORD_ALIGNED(p)) {
+		if (*p == '\0') {
+			return p - s;
+		}
+		p++;
+	}
+
+	/* look for the word holding the terminator */
+	w = (const word_t *)p;
+	while (HAS_ZERO(*w) == 0) {
+		w++;
+	}
+
+	p = (const char *)w;
+	while (*p != '\0') {
+		p++;
+	}
+
+	return p - s;
+#endif
 }
 
 /**
@@ -144,12 +191,40 @@ size_t strnlen(const char *s, size_t maxlen)
 
 int strcmp(const char *s1, const char *s2)
 {
+#ifndef CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SIZE
+	if (((uintptr_t)s1 & WORD_MASK) == ((uintptr_t)s2 & WORD_MASK)) {
+		const word_t *w1, *w2;
+
+		while (!IS_WORD_ALIGNED(s1)) {
+			if ((*s1 != *s2) || (*s1 == '\0')) {
+				goto out;
+			}
+			s1++;
+			s2++;
+		}
+
+		/* skip identical words without a terminator */
+		w1 = (const word_t *)s1;
+		w2 = (const word_t *)s2;
+		while ((*w1 == *w2) && (HAS_ZERO(*w1) == 0)) {
+			w1++;
+			w2++;
+		}
+
+		s1 = (const char *)w1;
+		s2 = (const char *)w2;
+	}
+#endif
+
 	while ((*s1 == *s2) && (*s1 != '\0')) {
 		s1++;
 		s2++;
 	}
 
-	return *s1 - *s2;
+#ifndef CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SIZE
+out:
+#endif
+	return *(const unsigned char *)s1 - *(const unsigned char *)s2;
 }
 
 /**
@@ -199,13 +274,43 @@ char *strncat(char *_MLIBC_RESTRICT dest, const char *_MLIBC_RESTRICT src,
  */
 int memcmp(const void *m1, const void *m2, size_t n)
 {
-	const char *c1 = m1;
-	const char *c2 = m2;
+	const unsigned char *c1 = m1;
+	const unsigned char *c2 = m2;
 
 	if (!n) {
 		return 0;
 	}
 
+#ifndef CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SIZE
+	if ((n > WORD_SIZE) &&
+	    (((uintptr_t)c1 & WORD_MASK) == ((uintptr_t)c2 & WORD_MASK))) {
+		const word_t *w1, *w2;
+
+		while (!IS_WORD_ALIGNED(c1)) {
+			if (*c1 != *c2) {
+				return *c1 - *c2;
+			}
+			c1++;
+			c2++;
+			n--;
+		}
+
+		/* skip identical words, the last byte is left to the loop
+		 * below
+		 */
+		w1 = (const word_t *)c1;
+		w2 = (const word_t *)c2;
+		while ((n > WORD_SIZE) && (*w1 == *w2)) {
+			w1++;
+			w2++;
+			n -= WORD_SIZE;
+		}
+
+		c1 = (const unsigned char *)w1;
+		c2 = (const unsigned char *)w2;
+	}
+#endif
+
 	while ((--n > 0) && (*c1 == *c2)) {
 		c1++;
 		c2++;
@@ -237,6 +342,13 @@ void *memmove(void *d, const void *s, size_t n)
 			dest[n] = src[n];
 		}
 	} else {
+#ifndef CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SIZE
+		if ((size_t) (src - dest) >= n) {
+			/* The buffers do not overlap at all */
+			return memcpy(d, s, n);
+		}
+#endif
+
 		/* It is safe to perform a forward-copy */
 		while (n > 0) {
 			*dest = *src;
@@ -256,6 +368,19 @@ void *memmove(void *d, const void *s, size_t n)
  * @return pointer to start of destination buffer
  */
 
+#if defined(CONFIG_MINIMAL_LIBC_X86_REP_STRING)
+void *memcpy(void *_MLIBC_RESTRICT d, const void *_MLIBC_RESTRICT s, size_t n)
+{
+	void *dest = d;
+
+	__asm__ volatile("rep movsb"
+			 : "+D" (d), "+S" (s), "+c" (n)
+			 :
+			 : "memory");
+
+	return dest;
+}
+#elif defined(CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SIZE)
 void *memcpy(void *_MLIBC_RESTRICT d, const void *_MLIBC_RESTRICT s, size_t n)
 {
 	/* attempt word-sized copying only if buffers have identical alignment */
@@ -299,6 +424,81 @@ void *memcpy(void *_MLIBC_RESTRICT d, const void *_MLIBC_RESTRICT s, size_t n)
 
 	return d;
 }
+#else
+void *memcpy(void *_MLIBC_RESTRICT d, const void *_MLIBC_RESTRICT s, size_t n)
+{
+	unsigned char *d_byte = (unsigned char *)d;
+	const unsigned char *s_byte = (const unsigned char *)s;
+
+	if (n >= WORD_SIZE) {
+		word_t *d_word;
+		const word_t *s_word;
+
+		/* do byte-sized copying until the destination is aligned */
+
+		while (!IS_WORD_ALIGNED(d_byte)) {
+			*(d_byte++) = *(s_byte++);
+			n--;
+		}
+
+		d_word = (word_t *)d_byte;
+
+		if (IS_WORD_ALIGNED(s_byte)) {
+			s_word = (const word_t *)s_byte;
+
+			while (n >= 4 * WORD_SIZE) {
+				d_word[0] = s_word[0];
+				d_word[1] = s_word[1];
+				d_word[2] = s_word[2];
+				d_word[3] = s_word[3];
+				d_word += 4;
+				s_word += 4;
+				n -= 4 * WORD_SIZE;
+			}
+
+			while (n >= WORD_SIZE) {
+				*(d_word++) = *(s_word++);
+				n -= WORD_SIZE;
+			}
+
+			s_byte = (const unsigned char *)s_word;
+		} else {
+			/* Only read aligned source words, and shift the
+			 * bytes of two of them into each destination word.
+			 */
+			unsigned int lo = ((uintptr_t)s_byte & WORD_MASK) * 8U;
+			unsigned int hi = WORD_SIZE * 8U - lo;
+			word_t prev, next;
+
+			s_word = (const word_t *)(s_byte - lo / 8U);
+			prev = *(s_word++);
+
+			while (n >= WORD_SIZE) {
+				next = *(s_word++);
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+				*(d_word++) = (prev >> lo) | (next << hi);
+#else
+				*(d_word++) = (prev << lo) | (next >> hi);
+#endif
+				prev = next;
+				n -= WORD_SIZE;
+				s_byte += WORD_SIZE;
+			}
+		}
+
+		d_byte = (unsigned char *)d_word;
+	}
+
+	/* do byte-sized copying until finished */
+
+	while (n > 0) {
+		*(d_byte++) = *(s_byte++);
+		n--;
+	}
+
+	return d;
+}
+#endif
 
 /**
  *
@@ -307,6 +507,19 @@ void *memcpy(void *_MLIBC_RESTRICT d, const void *_MLIBC_RESTRICT s, size_t n)
  * @return pointer to start of buffer
  */
 
+#ifdef CONFIG_MINIMAL_LIBC_X86_REP_STRING
+void *memset(void *buf, int c, size_t n)
+{
+	void *d = buf;
+
+	__asm__ volatile("rep stosb"
+			 : "+D" (d), "+c" (n)
+			 : "a" (c)
+			 : "memory");
+
+	return buf;
+}
+#else
 void *memset(void *buf, int c, size_t n)
 {
 	/* do byte-sized initialization until word-aligned or finished */
@@ -333,6 +546,17 @@ void *memset(void *buf, int c, size_t n)
 	c_word |= c_word << 32;
 #endif
 
+#ifndef CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SIZE
+	while (n >= 4 * sizeof(mem_word_t)) {
+		d_word[0] = c_word;
+		d_word[1] = c_word;
+		d_word[2] = c_word;
+		d_word[3] = c_word;
+		d_word += 4;
+		n -= 4 * sizeof(mem_word_t);
+	}
+#endif
+
 	while (n >= sizeof(mem_word_t)) {
 		*(d_word++) = c_word;
 		n -= sizeof(mem_word_t);
@@ -349,6 +573,7 @@ void *memset(void *buf, int c, size_t n)
 
 	return buf;
 }
+#endif
 
 /**
  *
@@ -359,6 +584,41 @@ void *memset(void *buf, int c, size_t n)
 
 void *memchr(const void *s, int c, size_t n)
 {
+#ifndef CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SIZE
+	const unsigned char *p = s;
+	unsigned char c_byte = (unsigned char)c;
+
+	while ((n > 0) && !IS_WORD_ALIGNED(p)) {
+		if (*p == c_byte) {
+			return (void *)p;
+		}
+		p++;
+		n--;
+	}
+
+	if (n >= WORD_SIZE) {
+		/* bytes equal to c are zero in w ^ c_word */
+		const word_t *w = (const word_t *)p;
+		word_t c_word = ONES * c_byte;
+
+		while ((n >= WORD_SIZE) && (HAS_ZERO(*w ^ c_word) == 0)) {
+			w++;
+			n -= WORD_SIZE;
+		}
+
+		p = (const unsigned char *)w;
+	}
+
+	while (n > 0) {
+		if (*p == c_byte) {
+			return (void *)p;
+		}
+		p++;
+		n--;
+	}
+
+	return NULL;
+#else
 	if (n != 0) {
 		const unsigned char *p = s;
 
@@ -371,4 +631,5 @@ void *memchr(const void *s, int c, size_t n)
 	}
 
 	return NULL;
+#endif
 }
@@ -73,6 +73,27 @@ bool sys_heap_validate(struct sys_heap *heap)
 	struct z_heap *h = heap->heap;
 	chunkid_t c;
 
+#if CONFIG_SYS_HEAP_SIZE_CLASSES > 0
+	/* Chunks cached in a size class must be in use (as far as the
+	 * rest of the heap is concerned) and of exactly the class size
+	 */
+	for (int i = 0; i < CONFIG_SYS_HEAP_SIZE_CLASSES; i++) {
+		u32_t n = 0;
+
+		for (c = h->classes[i].next; c != 0; c = free_next(h, c)) {
+			if (!in_bounds(h, c) || !used(h, c)
+			    || size(h, c) != i + 1
+			    || ++n > h->classes[i].count) {
+				return false;
+			}
+		}
+
+		if (n != h->classes[i].count) {
+			return false;
+		}
+	}
+#endif
+
 	/* Check the free lists: entry count should match, empty bit
 	 * should be correct, and all chunk entries should point into
 	 * valid unused chunks.  Mark those chunks USED, temporarily.
@@ -5,6 +5,7 @@
  */
 #include <sys/sys_heap.h>
 #include <kernel.h>
+#include <string.h>
 #include "heap.h"
 
 static void *chunk_mem(struct z_heap *h, chunkid_t c)
@@ -73,92 +74,170 @@ static ALWAYS_INLINE bool last_chunk(struct z_heap *h, chunkid_t c)
 	return (c + size(h, c)) == h->len;
 }
 
-/* Allocates (fit check has already been perfomred) from the next
- * chunk at the specified bucket level
+/* Splits chunk "lc" into a left chunk and a new free chunk starting
+ * at "rc".  The left chunk keeps its used flag, the right one is
+ * marked unused and not added to any free list.
  */
-static void *split_alloc(struct z_heap *h, int bidx, size_t sz)
+static void split_chunks(struct z_heap *h, chunkid_t lc, chunkid_t rc)
 {
-	CHECK(h->buckets[bidx].next != 0
-	      && sz <= size(h, h->buckets[bidx].next));
-
-	chunkid_t c = h->buckets[bidx].next;
-
-	free_list_remove(h, bidx, c);
-
-	/* Split off remainder if it's usefully large */
-	size_t rem = size(h, c) - sz;
-
-	CHECK(rem < h->len);
-
-	if (rem >= (big_heap(h) ? 2 : 1)) {
-		chunkid_t c2 = c + sz;
-		chunkid_t c3 = right_chunk(h, c);
-
-		chunk_set(h, c, SIZE_AND_USED, sz);
-		chunk_set(h, c2, SIZE_AND_USED, rem);
-		chunk_set(h, c2, LEFT_SIZE, sz);
-		if (!last_chunk(h, c2)) {
-			chunk_set(h, c3, LEFT_SIZE, rem);
-		}
-		free_list_add(h, c2);
+	CHECK(rc > lc);
+	CHECK(rc - lc < size(h, lc));
+
+	size_t sz0 = size(h, lc);
+	size_t lsz = rc - lc;
+	size_t rsz = sz0 - lsz;
+
+	set_chunk_size(h, lc, lsz);
+	chunk_set(h, rc, SIZE_AND_USED, rsz);
+	chunk_set(h, rc, LEFT_SIZE, lsz);
+	if (!last_chunk(h, rc)) {
+		chunk_set(h, right_chunk(h, rc), LEFT_SIZE, rsz);
 	}
-
-	chunk_set_used(h, c, true);
-
-	return chunk_mem(h, c);
 }
 
-void sys_heap_free(struct sys_heap *heap, void *mem)
+/* Does not modify free list or used flag of "lc" */
+static void merge_chunks(struct z_heap *h, chunkid_t lc, chunkid_t rc)
 {
-	if (mem == NULL) {
-		return; /* ISO C free() semantics */
+	size_t newsz = size(h, lc) + size(h, rc);
+
+	set_chunk_size(h, lc, newsz);
+	if (!last_chunk(h, lc)) {
+		chunk_set(h, right_chunk(h, lc), LEFT_SIZE, newsz);
 	}
+}
 
-	struct z_heap *h = heap->heap;
-	chunkid_t c = ((u8_t *)mem - chunk_header_bytes(h)
-		       - (u8_t *)h->buf) / CHUNK_UNIT;
+/* Returns an unused chunk to the heap, merging it with free neighbors */
+static void free_chunk(struct z_heap *h, chunkid_t c)
+{
+	CHECK(!used(h, c));
 
 	/* Merge with right chunk?  We can just absorb it. */
 	if (!last_chunk(h, c) && !used(h, right_chunk(h, c))) {
 		chunkid_t rc = right_chunk(h, c);
-		size_t newsz = size(h, c) + size(h, rc);
 
 		free_list_remove(h, bucket_idx(h, size(h, rc)), rc);
-		chunk_set(h, c, SIZE_AND_USED, newsz);
-		if (!last_chunk(h, c)) {
-			chunk_set(h, right_chunk(h, c), LEFT_SIZE, newsz);
-		}
+		merge_chunks(h, c, rc);
 	}
 
 	/* Merge with left chunk?  It absorbs us. */
 	if (c != h->chunk0 && !used(h, left_chunk(h, c))) {
 		chunkid_t lc = left_chunk(h, c);
-		chunkid_t rc = right_chunk(h, c);
-		size_t csz = size(h, c);
-		size_t merged_sz = csz + size(h, lc);
 
 		free_list_remove(h, bucket_idx(h, size(h, lc)), lc);
-		chunk_set(h, lc, SIZE_AND_USED, merged_sz);
-		if (!last_chunk(h, lc)) {
-			chunk_set(h, rc, LEFT_SIZE, merged_sz);
-		}
-
+		merge_chunks(h, lc, c);
 		c = lc;
 	}
 
-	chunk_set_used(h, c, false);
 	free_list_add(h, c);
 }
 
-void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
+/* Inverse of chunk_mem().  Pointers up to CHUNK_UNIT - 1 bytes past
+ * the start of a chunk's memory (as returned by
+ * sys_heap_aligned_alloc()) map back to the same chunk.
+ */
+static chunkid_t mem_to_chunkid(struct z_heap *h, void *p)
+{
+	return ((u8_t *)p - chunk_header_bytes(h) - (u8_t *)h->buf)
+		/ CHUNK_UNIT;
+}
+
+#if CONFIG_SYS_HEAP_SIZE_CLASSES > 0
+/* Exact-fit front end for small allocations.  Freed chunks of up to
+ * CONFIG_SYS_HEAP_SIZE_CLASSES units are not merged back into the
+ * buckets.  Up to CONFIG_SYS_HEAP_SIZE_CLASS_DEPTH of each size are
+ * kept, still marked used so their neighbors won't absorb them, and
+ * handed out again to the next request for exactly that size.  Both
+ * directions are a couple of list operations.  The cached chunks are
+ * flushed back into the buckets whenever the buckets can't satisfy a
+ * request, so they never cause an allocation to fail.
+ */
+static chunkid_t size_class_alloc(struct z_heap *h, size_t sz)
+{
+	if (sz > CONFIG_SYS_HEAP_SIZE_CLASSES) {
+		return 0;
+	}
+
+	struct z_heap_class *cl = &h->classes[sz - 1];
+	chunkid_t c = cl->next;
+
+	if (c != 0) {
+		CHECK(used(h, c) && size(h, c) == sz);
+		cl->next = free_next(h, c);
+		cl->count--;
+	}
+
+	return c;
+}
+
+static bool size_class_free(struct z_heap *h, chunkid_t c)
+{
+	size_t sz = size(h, c);
+
+	if (sz > CONFIG_SYS_HEAP_SIZE_CLASSES) {
+		return false;
+	}
+
+	struct z_heap_class *cl = &h->classes[sz - 1];
+
+	if (cl->count >= CONFIG_SYS_HEAP_SIZE_CLASS_DEPTH) {
+		return false;
+	}
+
+	chunk_set(h, c, FREE_NEXT, cl->next);
+	cl->next = c;
+	cl->count++;
+
+	return true;
+}
+
+static bool size_class_flush(struct z_heap *h)
+{
+	bool flushed = false;
+
+	for (int i = 0; i < CONFIG_SYS_HEAP_SIZE_CLASSES; i++) {
+		struct z_heap_class *cl = &h->classes[i];
+
+		while (cl->next != 0) {
+			chunkid_t c = cl->next;
+
+			cl->next = free_next(h, c);
+			chunk_set_used(h, c, false);
+			free_chunk(h, c);
+			flushed = true;
+		}
+		cl->count = 0;
+	}
+
+	return flushed;
+}
+#endif
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+static void stats_alloc(struct z_heap *h, size_t sz)
+{
+	h->allocated += sz;
+	h->max_allocated = MAX(h->max_allocated, h->allocated);
+}
+
+static void stats_free(struct z_heap *h, size_t sz)
+{
+	h->allocated -= sz;
+}
+#else
+#define stats_alloc(h, sz) do {} while (false)
+#define stats_free(h, sz) do {} while (false)
+#endif
+
+/* Finds a free chunk of at least sz units and removes it from its
+ * free list, without splitting it.  Returns 0 if none fits.
+ */
+static chunkid_t bucket_alloc(struct z_heap *h, size_t sz)
 {
-	struct z_heap *h = heap->heap;
-	size_t sz = bytes_to_chunksz(h, bytes);
 	int bi = bucket_idx(h, sz);
 	struct z_heap_bucket *b = &h->buckets[bi];
 
-	if (bytes == 0 || bi > bucket_idx(h, h->len)) {
-		return NULL;
+	if (bi > bucket_idx(h, h->len)) {
+		return 0;
 	}
 
 	/* First try a bounded count of items from the minimal bucket
@@ -180,7 +259,10 @@ void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
 	for (int i = 0; i < loops; i++) {
 		CHECK(b->next != 0);
 		if (size(h, b->next) >= sz) {
-			return split_alloc(h, bi, sz);
+			chunkid_t c = b->next;
+
+			free_list_remove(h, bi, c);
+			return c;
 		}
 		b->next = free_next(h, b->next);
 	}
@@ -192,11 +274,195 @@ void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
 
 	if ((bmask & h->avail_buckets) != 0) {
 		int minbucket = __builtin_ctz(bmask & h->avail_buckets);
+		chunkid_t c = h->buckets[minbucket].next;
+
+		free_list_remove(h, minbucket, c);
+		CHECK(size(h, c) >= sz);
+		return c;
+	}
+
+	return 0;
+}
+
+static chunkid_t alloc_chunk(struct z_heap *h, size_t sz)
+{
+	chunkid_t c = bucket_alloc(h, sz);
+
+#if CONFIG_SYS_HEAP_SIZE_CLASSES > 0
+	if (c == 0 && size_class_flush(h)) {
+		c = bucket_alloc(h, sz);
+	}
+#endif
+
+	return c;
+}
+
+/* Marks the first sz units of an allocated chunk used and returns
+ * the remainder to the heap if it's usefully large
+ */
+static void trim_chunk(struct z_heap *h, chunkid_t c, size_t sz)
+{
+	CHECK(size(h, c) >= sz);
+
+	chunk_set_used(h, c, true);
+
+	if (size(h, c) - sz >= min_chunk_size(h)) {
+		split_chunks(h, c, c + sz);
+		free_chunk(h, c + sz);
+	}
+}
+
+void sys_heap_free(struct sys_heap *heap, void *mem)
+{
+	if (mem == NULL) {
+		return; /* ISO C free() semantics */
+	}
+
+	struct z_heap *h = heap->heap;
+	chunkid_t c = mem_to_chunkid(h, mem);
+
+	CHECK(used(h, c));
+
+	stats_free(h, size(h, c));
+
+#if CONFIG_SYS_HEAP_SIZE_CLASSES > 0
+	if (size_class_free(h, c)) {
+		return;
+	}
+#endif
+
+	chunk_set_used(h, c, false);
+	free_chunk(h, c);
+}
+
+void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
+{
+	struct z_heap *h = heap->heap;
+	size_t sz = bytes_to_chunksz(h, bytes);
+	chunkid_t c;
+
+	if (bytes == 0) {
+		return NULL;
+	}
+
+#if CONFIG_SYS_HEAP_SIZE_CLASSES > 0
+	c = size_class_alloc(h, sz);
+	if (c != 0) {
+		stats_alloc(h, sz);
+		return chunk_mem(h, c);
+	}
+#endif
+
+	c = alloc_chunk(h, sz);
+	if (c == 0) {
+		return NULL;
+	}
+
+	trim_chunk(h, c, sz);
+	stats_alloc(h, size(h, c));
+
+	return chunk_mem(h, c);
+}
+
+void *sys_heap_aligned_alloc(struct sys_heap *heap, size_t align, size_t bytes)
+{
+	struct z_heap *h = heap->heap;
+
+	CHECK((align & (align - 1)) == 0);
+
+	if (align <= chunk_header_bytes(h)) {
+		return sys_heap_alloc(heap, bytes);
+	}
+
+	if (bytes == 0) {
+		return NULL;
+	}
+
+	/* Over-allocate so that an aligned pointer exists in the chunk
+	 * with room for a minimal free chunk in front of it.  With
+	 * 8-byte chunks and a 4-byte header the aligned pointer can't
+	 * be the start of a chunk's memory, so it lands 4 bytes into
+	 * it, which mem_to_chunkid() still maps back to the chunk.
+	 */
+	size_t padded = bytes + align * min_chunk_size(h);
+	chunkid_t c0 = alloc_chunk(h, bytes_to_chunksz(h, padded));
+
+	if (c0 == 0) {
+		return NULL;
+	}
+
+	u8_t *mem = (u8_t *)ROUND_UP(chunk_mem(h, c0), align);
+	chunkid_t c = mem_to_chunkid(h, mem);
 
-		return split_alloc(h, minbucket, sz);
+	if (c != c0 && c - c0 < min_chunk_size(h)) {
+		mem += align;
+		c = mem_to_chunkid(h, mem);
 	}
 
-	return NULL;
+	/* Give back the unused prefix... */
+	if (c != c0) {
+		split_chunks(h, c0, c);
+		chunk_set_used(h, c, true);
+		free_chunk(h, c0);
+	}
+
+	/* ...and the unused suffix */
+	trim_chunk(h, c, chunksz(mem + bytes - (u8_t *)&h->buf[c]));
+	stats_alloc(h, size(h, c));
+
+	return mem;
+}
+
+void *sys_heap_realloc(struct sys_heap *heap, void *ptr, size_t bytes)
+{
+	struct z_heap *h = heap->heap;
+
+	if (ptr == NULL) {
+		return sys_heap_alloc(heap, bytes);
+	}
+
+	if (bytes == 0) {
+		sys_heap_free(heap, ptr);
+		return NULL;
+	}
+
+	chunkid_t c = mem_to_chunkid(h, ptr);
+	size_t offset = (u8_t *)ptr - (u8_t *)&h->buf[c];
+	size_t sz = chunksz(offset + bytes);
+
+	CHECK(used(h, c));
+
+	stats_free(h, size(h, c));
+
+	/* Shrinking, or growing into a free right neighbor, is done in
+	 * place
+	 */
+	if (size(h, c) < sz && !last_chunk(h, c)) {
+		chunkid_t rc = right_chunk(h, c);
+
+		if (!used(h, rc) && size(h, c) + size(h, rc) >= sz) {
+			free_list_remove(h, bucket_idx(h, size(h, rc)), rc);
+			merge_chunks(h, c, rc);
+		}
+	}
+
+	if (size(h, c) >= sz) {
+		trim_chunk(h, c, sz);
+		stats_alloc(h, size(h, c));
+		return ptr;
+	}
+
+	stats_alloc(h, size(h, c));
+
+	/* Otherwise move it */
+	void *ptr2 = sys_heap_alloc(heap, bytes);
+
+	if (ptr2 != NULL) {
+		memcpy(ptr2, ptr, MIN(size(h, c) * CHUNK_UNIT - offset, bytes));
+		sys_heap_free(heap, ptr);
+	}
+
+	return ptr2;
 }
 
 void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes)
@@ -222,6 +488,13 @@ void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes)
 	h->len = buf_sz;
 	h->size_mask = (1 << (big_heap(h) ? 31 : 15)) - 1;
 	h->avail_buckets = 0;
+#if CONFIG_SYS_HEAP_SIZE_CLASSES > 0
+	(void)memset(h->classes, 0, sizeof(h->classes));
+#endif
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	h->allocated = 0;
+	h->max_allocated = 0;
+#endif
 
 	size_t buckets_bytes = ((bucket_idx(h, buf_sz) + 1)
 				* sizeof(struct z_heap_bucket));
@@ -236,3 +509,44 @@ void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes)
 	chunk_set(h, h->chunk0, SIZE_AND_USED, buf_sz - h->chunk0);
 	free_list_add(h, h->chunk0);
 }
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+void sys_heap_runtime_stats_get(struct sys_heap *heap,
+				struct sys_heap_runtime_stats *stats)
+{
+	struct z_heap *h = heap->heap;
+	size_t largest = 0, nfree = 0;
+
+	for (int b = 0; b <= bucket_idx(h, h->len); b++) {
+		nfree += h->buckets[b].list_size;
+	}
+
+	/* The largest free chunk is in the highest non-empty bucket,
+	 * which is the only list that needs walking
+	 */
+	if (h->avail_buckets != 0) {
+		int b = 31 - __builtin_clz(h->avail_buckets);
+		chunkid_t c0 = h->buckets[b].next, c = c0;
+
+		do {
+			largest = MAX(largest, size(h, c));
+			c = free_next(h, c);
+		} while (c != c0);
+	}
+
+	stats->allocated_bytes = h->allocated * CHUNK_UNIT;
+	stats->max_allocated_bytes = h->max_allocated * CHUNK_UNIT;
+	stats->free_bytes = (h->len - h->chunk0 - h->allocated) * CHUNK_UNIT;
+	stats->largest_free_bytes = largest * CHUNK_UNIT;
+	stats->free_chunks = nfree;
+	stats->fragmentation = stats->free_bytes == 0 ? 0 :
+		100 - (stats->largest_free_bytes * 100) / stats->free_bytes;
+}
+
+void sys_heap_runtime_stats_reset_max(struct sys_heap *heap)
+{
+	struct z_heap *h = heap->heap;
+
+	h->max_allocated = h->allocated;
+}
+#endif
@@ -44,6 +44,11 @@
  * category.  The free list pointers exist only for free chunks,
  * obviously.  This memory is part of the user's buffer when
  * allocated.
+ *
+ * With CONFIG_SYS_HEAP_SIZE_CLASSES, recently freed chunks of the
+ * smallest sizes are kept marked used on singly linked per-size lists
+ * (threaded through FREE_NEXT) instead of going back to the buckets,
+ * see size_class_alloc() in heap.c.
  */
 typedef size_t chunkid_t;
 
@@ -51,6 +56,13 @@ typedef size_t chunkid_t;
 
 enum chunk_fields { SIZE_AND_USED, LEFT_SIZE, FREE_PREV, FREE_NEXT };
 
+#if CONFIG_SYS_HEAP_SIZE_CLASSES > 0
+struct z_heap_class {
+	chunkid_t next;
+	u32_t count;
+};
+#endif
+
 struct z_heap {
 	u64_t *buf;
 	struct z_heap_bucket *buckets;
@@ -58,6 +70,15 @@ struct z_heap {
 	u32_t size_mask;
 	u32_t chunk0;
 	u32_t avail_buckets;
+#if CONFIG_SYS_HEAP_SIZE_CLASSES > 0
+	/* classes[i] caches free chunks of exactly i + 1 units */
+	struct z_heap_class classes[CONFIG_SYS_HEAP_SIZE_CLASSES];
+#endif
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	/* chunk units handed out to users, and its high water mark */
+	u32_t allocated;
+	u32_t max_allocated;
+#endif
 };
 
 struct z_heap_bucket {
@@ -115,6 +136,13 @@ static inline void chunk_set_used(struct z_heap *h, chunkid_t c,
 		  size(h, c) | (used ? (h->size_mask + 1) : 0));
 }
 
+/* Changes the size of a chunk, preserving its used flag */
+static inline void set_chunk_size(struct z_heap *h, chunkid_t c, size_t sz)
+{
+	chunk_set(h, c, SIZE_AND_USED,
+		  sz | (used(h, c) ? (h->size_mask + 1) : 0));
+}
+
 static inline chunkid_t left_size(struct z_heap *h, chunkid_t c)
 {
 	return chunk_field(h, c, LEFT_SIZE);
@@ -145,6 +173,12 @@ static inline size_t chunk_header_bytes(struct z_heap *h)
 	return big_heap(h) ? 8 : 4;
 }
 
+/* Smallest chunk that can hold the free list pointers */
+static inline size_t min_chunk_size(struct z_heap *h)
+{
+	return big_heap(h) ? 2 : 1;
+}
+
 static inline size_t chunksz(size_t bytes)
 {
 	return (bytes + CHUNK_UNIT - 1) / CHUNK_UNIT;
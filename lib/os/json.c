@@ -16,6 +16,9 @@
 #include <zephyr/types.h>
 
 #include <data/json.h>
+#ifdef CONFIG_NET_BUF
+#include <net/buf.h>
+#endif
 
 struct token {
 	enum json_tokens type;
@@ -599,6 +602,414 @@ int json_obj_parse(char *payload, size_t len,
 	return obj_parse(&obj, descr, descr_len, val);
 }
 
+BUILD_ASSERT(JSON_STREAM_MAX_DEPTH <= 32, "depth must fit json_stream.arrays");
+
+enum stream_state {
+	STREAM_VALUE,
+	STREAM_VALUE_OR_END,
+	STREAM_KEY,
+	STREAM_KEY_OR_END,
+	STREAM_KEY_STRING,
+	STREAM_COLON,
+	STREAM_STRING,
+	STREAM_NUMBER,
+	STREAM_LITERAL,
+	STREAM_AFTER_VALUE,
+	STREAM_DONE,
+};
+
+/* Values of json_stream.esc inside a string: between ESC_NONE and
+ * ESC_BACKSLASH, the number of hex digits of a \u escape still expected.
+ */
+#define ESC_NONE 0
+#define ESC_BACKSLASH 5
+
+static const char *const literals[] = { "true", "false", "null" };
+static const enum json_tokens literal_tokens[] = {
+	JSON_TOK_TRUE, JSON_TOK_FALSE, JSON_TOK_NULL
+};
+
+static bool is_ws(char chr)
+{
+	return chr == ' ' || chr == '\t' || chr == '\n' || chr == '\r';
+}
+
+static bool in_array(struct json_stream *s)
+{
+	return s->depth > 0 && (s->arrays & BIT(s->depth - 1));
+}
+
+static int stream_put(struct json_stream *s, const char *data, size_t len)
+{
+	if (len > s->buf_size - s->len) {
+		return -ENOMEM;
+	}
+
+	memcpy(s->buf + s->len, data, len);
+	s->len += len;
+
+	return 0;
+}
+
+static int stream_emit(struct json_stream *s, enum json_tokens type)
+{
+	struct json_stream_token token = {
+		.type = type,
+		.path = s->buf,
+		.path_len = s->path_len,
+		.value = s->buf + s->path_len,
+		.value_len = s->len - s->path_len,
+		.depth = s->depth,
+	};
+
+	if (s->depth > 0 && !in_array(s)) {
+		size_t outer = s->outer_path_len[s->depth - 1];
+
+		/* Skip the '/' in front of the key */
+		token.key = s->buf + outer + 1;
+		token.key_len = s->path_len - outer - 1;
+	}
+
+	return s->cb(&token, s->user_data);
+}
+
+/* Adds the index of a new array element to the path */
+static int stream_value_begin(struct json_stream *s)
+{
+	char digits[11];
+	u32_t idx;
+	int i = sizeof(digits);
+	int ret;
+
+	if (!in_array(s)) {
+		return 0;
+	}
+
+	idx = s->index[s->depth - 1]++;
+	do {
+		digits[--i] = '0' + idx % 10U;
+		idx /= 10U;
+	} while (idx);
+	digits[--i] = '/';
+
+	ret = stream_put(s, &digits[i], sizeof(digits) - i);
+	s->path_len = s->len;
+
+	return ret;
+}
+
+/* Drops the value from the scratch buffer and its name from the path */
+static void stream_value_end(struct json_stream *s)
+{
+	s->path_len = s->depth > 0 ? s->outer_path_len[s->depth - 1] : 0;
+	s->len = s->path_len;
+	s->state = s->depth > 0 ? STREAM_AFTER_VALUE : STREAM_DONE;
+}
+
+static int stream_scalar_end(struct json_stream *s, enum json_tokens type)
+{
+	int ret = stream_emit(s, type);
+
+	stream_value_end(s);
+
+	return ret;
+}
+
+static int stream_container_start(struct json_stream *s, bool array)
+{
+	int ret;
+
+	if (s->depth == JSON_STREAM_MAX_DEPTH || s->path_len > UINT16_MAX) {
+		return -ENOMEM;
+	}
+
+	ret = stream_emit(s, array ? JSON_TOK_LIST_START :
+				     JSON_TOK_OBJECT_START);
+	if (ret < 0) {
+		return ret;
+	}
+
+	s->outer_path_len[s->depth] = s->path_len;
+	s->index[s->depth] = 0U;
+	WRITE_BIT(s->arrays, s->depth, array);
+	s->depth++;
+	s->state = array ? STREAM_VALUE_OR_END : STREAM_KEY_OR_END;
+
+	return 0;
+}
+
+static int stream_container_end(struct json_stream *s, char chr)
+{
+	bool array = in_array(s);
+	int ret;
+
+	if (chr != (array ? ']' : '}')) {
+		return -EINVAL;
+	}
+
+	s->depth--;
+	s->path_len = s->outer_path_len[s->depth];
+	s->len = s->path_len;
+
+	ret = stream_emit(s, array ? JSON_TOK_LIST_END : JSON_TOK_OBJECT_END);
+	stream_value_end(s);
+
+	return ret;
+}
+
+static int stream_value(struct json_stream *s, char chr)
+{
+	int ret;
+
+	ret = stream_value_begin(s);
+	if (ret < 0) {
+		return ret;
+	}
+
+	switch (chr) {
+	case '{':
+		return stream_container_start(s, false);
+	case '[':
+		return stream_container_start(s, true);
+	case '"':
+		s->state = STREAM_STRING;
+		s->esc = ESC_NONE;
+		return 0;
+	case 't':
+	case 'f':
+	case 'n':
+		s->literal = chr == 't' ? 0 : chr == 'f' ? 1 : 2;
+		s->literal_pos = 1U;
+		s->state = STREAM_LITERAL;
+		return 0;
+	default:
+		if (chr == '-' || isdigit((unsigned char)chr)) {
+			s->state = STREAM_NUMBER;
+			return stream_put(s, &chr, 1);
+		}
+
+		return -EINVAL;
+	}
+}
+
+/* Copies the characters of a string from data into the scratch buffer.
+ * Returns 1 once the closing quote has been found, 0 if the string goes
+ * on in the next chunk, with the number of bytes used in *consumed.
+ */
+static int stream_string(struct json_stream *s, const char *data, size_t len,
+			 size_t *consumed)
+{
+	size_t i = 0;
+	size_t run;
+	int ret;
+
+	while (i < len) {
+		char chr = data[i];
+
+		if (s->esc == ESC_BACKSLASH) {
+			if (chr == 'u') {
+				s->esc = 4U;
+			} else if (strchr("\"\\/bfnrt", chr) && chr != '\0') {
+				s->esc = ESC_NONE;
+			} else {
+				return -EINVAL;
+			}
+		} else if (s->esc != ESC_NONE) {
+			if (!isxdigit((unsigned char)chr)) {
+				return -EINVAL;
+			}
+			s->esc--;
+		} else if (chr == '\\') {
+			s->esc = ESC_BACKSLASH;
+		} else if (chr == '"') {
+			*consumed = i + 1;
+			return 1;
+		} else {
+			/* Copy a run of plain characters at once */
+			for (run = i + 1; run < len; run++) {
+				if (data[run] == '"' || data[run] == '\\') {
+					break;
+				}
+			}
+
+			ret = stream_put(s, &data[i], run - i);
+			if (ret < 0) {
+				return ret;
+			}
+
+			i = run;
+			continue;
+		}
+
+		ret = stream_put(s, &chr, 1);
+		if (ret < 0) {
+			return ret;
+		}
+		i++;
+	}
+
+	*consumed = len;
+	return 0;
+}
+
+static int stream_feed(struct json_stream *s, const char *data, size_t len)
+{
+	size_t i = 0;
+	size_t consumed;
+	int ret = 0;
+
+	while (i < len) {
+		char chr = data[i];
+
+		switch (s->state) {
+		case STREAM_STRING:
+		case STREAM_KEY_STRING:
+			ret = stream_string(s, &data[i], len - i, &consumed);
+			if (ret < 0) {
+				return ret;
+			}
+
+			i += consumed;
+			if (ret == 0) {
+				continue;
+			}
+
+			if (s->state == STREAM_KEY_STRING) {
+				s->path_len = s->len;
+				s->state = STREAM_COLON;
+				ret = 0;
+			} else {
+				ret = stream_scalar_end(s, JSON_TOK_STRING);
+			}
+			break;
+		case STREAM_NUMBER:
+			if (isdigit((unsigned char)chr) || chr == '.' ||
+			    chr == 'e' || chr == 'E' || chr == '+' ||
+			    chr == '-') {
+				ret = stream_put(s, &chr, 1);
+				i++;
+				break;
+			}
+
+			/* The delimiter is handled by the next state */
+			ret = stream_scalar_end(s, JSON_TOK_NUMBER);
+			if (ret < 0) {
+				return ret;
+			}
+			continue;
+		case STREAM_LITERAL:
+			if (chr != literals[s->literal][s->literal_pos]) {
+				return -EINVAL;
+			}
+
+			i++;
+			if (literals[s->literal][++s->literal_pos] == '\0') {
+				ret = stream_scalar_end(s,
+						literal_tokens[s->literal]);
+			}
+			break;
+		default:
+			i++;
+			if (is_ws(chr)) {
+				continue;
+			}
+
+			switch (s->state) {
+			case STREAM_VALUE_OR_END:
+				if (chr == ']') {
+					ret = stream_container_end(s, chr);
+					break;
+				}
+				/* fallthrough */
+			case STREAM_VALUE:
+				ret = stream_value(s, chr);
+				break;
+			case STREAM_KEY_OR_END:
+				if (chr == '}') {
+					ret = stream_container_end(s, chr);
+					break;
+				}
+				/* fallthrough */
+			case STREAM_KEY:
+				if (chr != '"') {
+					return -EINVAL;
+				}
+
+				s->state = STREAM_KEY_STRING;
+				s->esc = ESC_NONE;
+				ret = stream_put(s, "/", 1);
+				break;
+			case STREAM_COLON:
+				if (chr != ':') {
+					return -EINVAL;
+				}
+
+				s->state = STREAM_VALUE;
+				break;
+			case STREAM_AFTER_VALUE:
+				if (chr == ',') {
+					s->state = in_array(s) ? STREAM_VALUE :
+								 STREAM_KEY;
+					break;
+				}
+
+				ret = stream_container_end(s, chr);
+				break;
+			default:
+				/* Only whitespace after the document */
+				return -EINVAL;
+			}
+		}
+
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+void json_stream_init(struct json_stream *stream, char *buf, size_t buf_size,
+		      json_stream_cb_t cb, void *user_data)
+{
+	memset(stream, 0, sizeof(*stream));
+	stream->cb = cb;
+	stream->user_data = user_data;
+	stream->buf = buf;
+	stream->buf_size = buf_size;
+	stream->state = STREAM_VALUE;
+}
+
+int json_stream_feed(struct json_stream *stream, const char *data,
+		     size_t len)
+{
+	if (stream->err == 0) {
+		stream->err = stream_feed(stream, data, len);
+	}
+
+	return stream->err;
+}
+
+int json_stream_finish(struct json_stream *stream)
+{
+	if (stream->err != 0) {
+		return stream->err;
+	}
+
+	if (stream->state == STREAM_NUMBER && stream->depth == 0) {
+		stream->err = stream_scalar_end(stream, JSON_TOK_NUMBER);
+		if (stream->err != 0) {
+			return stream->err;
+		}
+	}
+
+	if (stream->state != STREAM_DONE) {
+		stream->err = -EINVAL;
+	}
+
+	return stream->err;
+}
+
 static char escape_as(char chr)
 {
 	switch (chr) {
@@ -625,21 +1036,33 @@ static int json_escape_internal(const char *str,
 				json_append_bytes_t append_bytes,
 				void *data)
 {
+	const char *run = str;
 	const char *cur;
 	int ret = 0;
 
+	/* Append runs of characters which need no escaping at once */
 	for (cur = str; ret == 0 && *cur; cur++) {
 		char escaped = escape_as(*cur);
 
 		if (escaped) {
 			char bytes[2] = { '\\', escaped };
 
+			if (cur > run) {
+				ret = append_bytes(run, cur - run, data);
+				if (ret != 0) {
+					break;
+				}
+			}
+
 			ret = append_bytes(bytes, 2, data);
-		} else {
-			ret = append_bytes(cur, 1, data);
+			run = cur + 1;
 		}
 	}
 
+	if (ret == 0 && cur > run) {
+		ret = append_bytes(run, cur - run, data);
+	}
+
 	return ret;
 }
 
@@ -777,17 +1200,19 @@ static int num_encode(const s32_t *num, json_append_bytes_t append_bytes,
 		      void *data)
 {
 	char buf[3 * sizeof(s32_t)];
-	int ret;
+	char *pos = buf + sizeof(buf);
+	u32_t val = *num < 0 ? -(u32_t)*num : (u32_t)*num;
 
-	ret = snprintk(buf, sizeof(buf), "%d", *num);
-	if (ret < 0) {
-		return ret;
-	}
-	if (ret >= (int)sizeof(buf)) {
-		return -ENOMEM;
+	do {
+		*--pos = '0' + val % 10U;
+		val /= 10U;
+	} while (val);
+
+	if (*num < 0) {
+		*--pos = '-';
 	}
 
-	return append_bytes(buf, (size_t)ret, data);
+	return append_bytes(pos, buf + sizeof(buf) - pos, data);
 }
 
 static int bool_encode(const bool *value, json_append_bytes_t append_bytes,
@@ -895,6 +1320,48 @@ int json_obj_encode_buf(const struct json_obj_descr *descr, size_t descr_len,
 			       &appender);
 }
 
+#ifdef CONFIG_NET_BUF
+static int append_bytes_to_net_buf(const char *bytes, size_t len, void *data)
+{
+	struct net_buf **frag = data;
+
+	while (len > 0) {
+		size_t room = net_buf_tailroom(*frag);
+
+		if (room == 0) {
+			if ((*frag)->frags == NULL) {
+				return -ENOMEM;
+			}
+
+			*frag = (*frag)->frags;
+			continue;
+		}
+
+		room = MIN(room, len);
+		net_buf_add_mem(*frag, bytes, room);
+		bytes += room;
+		len -= room;
+	}
+
+	return 0;
+}
+
+int json_obj_encode_net_buf(const struct json_obj_descr *descr,
+			    size_t descr_len, const void *val,
+			    struct net_buf *buf)
+{
+	struct net_buf *frag = buf;
+
+	/* Start after the data already in the chain */
+	while (frag->frags != NULL && frag->frags->len > 0) {
+		frag = frag->frags;
+	}
+
+	return json_obj_encode(descr, descr_len, val, append_bytes_to_net_buf,
+			       &frag);
+}
+#endif /* CONFIG_NET_BUF */
+
 static int measure_bytes(const char *bytes, size_t len, void *data)
 {
 	ssize_t *total = data;
@@ -20,9 +20,32 @@
 #include <syscall_handler.h>
 #include <logging/log.h>
 #include <sys/types.h>
+#include <sys/ring_buffer.h>
 
 typedef int (*out_func_t)(int c, void *ctx);
 
+/* Arguments of a message being formatted: either a va_list, or the
+ * record stored by printk_deferred(), where each argument is packed
+ * with the size of its promoted type.
+ */
+struct arg_src {
+	va_list ap;
+	const u8_t *pkg;
+};
+
+static inline const u8_t *pkg_next(struct arg_src *src, size_t size)
+{
+	const u8_t *arg = src->pkg;
+
+	src->pkg += size;
+	return arg;
+}
+
+#define NEXT_ARG(src, type)						\
+	((src)->pkg != NULL ?						\
+	 UNALIGNED_GET((type *)pkg_next((src), sizeof(type))) :		\
+	 va_arg((src)->ap, type))
+
 enum pad_type {
 	PAD_NONE,
 	PAD_ZERO_BEFORE,
@@ -94,16 +117,8 @@ static void print_err(out_func_t out, void *ctx)
 	out('R', ctx);
 }
 
-/**
- * @brief Printk internals
- *
- * See printk() for description.
- * @param fmt Format string
- * @param ap Variable parameters
- *
- * @return N/A
- */
-void z_vprintk(out_func_t out, void *ctx, const char *fmt, va_list ap)
+static void prf(out_func_t out, void *ctx, const char *fmt,
+		struct arg_src *src)
 {
 	int might_format = 0; /* 1 if encountered a '%' */
 	enum pad_type padding = PAD_NONE;
@@ -173,11 +188,12 @@ void z_vprintk(out_func_t out, void *ctx, const char *fmt, va_list ap)
 				long d;
 
 				if (length_mod == 'z') {
-					d = va_arg(ap, ssize_t);
+					d = NEXT_ARG(src, ssize_t);
 				} else if (length_mod == 'l') {
-					d = va_arg(ap, long);
+					d = NEXT_ARG(src, long);
 				} else if (length_mod == 'L') {
-					long long lld = va_arg(ap, long long);
+					long long lld =
+						NEXT_ARG(src, long long);
 					if (lld > __LONG_MAX__ ||
 					    lld < ~__LONG_MAX__) {
 						print_err(out, ctx);
@@ -185,7 +201,7 @@ void z_vprintk(out_func_t out, void *ctx, const char *fmt, va_list ap)
 					}
 					d = lld;
 				} else {
-					d = va_arg(ap, int);
+					d = NEXT_ARG(src, int);
 				}
 
 				if (d < 0) {
@@ -201,19 +217,19 @@ void z_vprintk(out_func_t out, void *ctx, const char *fmt, va_list ap)
 				unsigned long u;
 
 				if (length_mod == 'z') {
-					u = va_arg(ap, size_t);
+					u = NEXT_ARG(src, size_t);
 				} else if (length_mod == 'l') {
-					u = va_arg(ap, unsigned long);
+					u = NEXT_ARG(src, unsigned long);
 				} else if (length_mod == 'L') {
-					unsigned long long llu =
-						va_arg(ap, unsigned long long);
+					unsigned long long llu = NEXT_ARG(src,
+						unsigned long long);
 					if (llu > ~0UL) {
 						print_err(out, ctx);
 						break;
 					}
 					u = llu;
 				} else {
-					u = va_arg(ap, unsigned int);
+					u = NEXT_ARG(src, unsigned int);
 				}
 
 				_printk_dec_ulong(out, ctx, u, padding,
@@ -236,13 +252,13 @@ void z_vprintk(out_func_t out, void *ctx, const char *fmt, va_list ap)
 				unsigned long long x;
 
 				if (*fmt == 'p') {
-					x = (uintptr_t)va_arg(ap, void *);
+					x = (uintptr_t)NEXT_ARG(src, void *);
 				} else if (length_mod == 'l') {
-					x = va_arg(ap, unsigned long);
+					x = NEXT_ARG(src, unsigned long);
 				} else if (length_mod == 'L') {
-					x = va_arg(ap, unsigned long long);
+					x = NEXT_ARG(src, unsigned long long);
 				} else {
-					x = va_arg(ap, unsigned int);
+					x = NEXT_ARG(src, unsigned int);
 				}
 
 				_printk_hex_ulong(out, ctx, x, padding,
@@ -250,7 +266,7 @@ void z_vprintk(out_func_t out, void *ctx, const char *fmt, va_list ap)
 				break;
 			}
 			case 's': {
-				char *s = va_arg(ap, char *);
+				char *s = NEXT_ARG(src, char *);
 				char *start = s;
 
 				while (*s) {
@@ -266,7 +282,7 @@ void z_vprintk(out_func_t out, void *ctx, const char *fmt, va_list ap)
 				break;
 			}
 			case 'c': {
-				int c = va_arg(ap, int);
+				int c = NEXT_ARG(src, int);
 
 				out(c, ctx);
 				break;
@@ -287,6 +303,24 @@ still_might_format:
 	}
 }
 
+/**
+ * @brief Printk internals
+ *
+ * See printk() for description.
+ * @param fmt Format string
+ * @param ap Variable parameters
+ *
+ * @return N/A
+ */
+void z_vprintk(out_func_t out, void *ctx, const char *fmt, va_list ap)
+{
+	struct arg_src src = { .pkg = NULL };
+
+	va_copy(src.ap, ap);
+	prf(out, ctx, fmt, &src);
+	va_end(src.ap);
+}
+
 #ifdef CONFIG_PRINTK
 #ifdef CONFIG_USERSPACE
 struct buf_out_context {
@@ -406,6 +440,116 @@ void printk(const char *fmt, ...)
 	}
 	va_end(ap);
 }
+
+#ifdef CONFIG_PRINTK_DEFERRED
+RING_BUF_ITEM_DECLARE_SIZE(z_printk_deferred_buf,
+			   CONFIG_PRINTK_DEFERRED_BUFFER_SIZE / sizeof(u32_t));
+
+/* Serializes producers, the consumer side is guarded by deferred_busy */
+static struct k_spinlock deferred_lock;
+static atomic_t deferred_busy;
+static atomic_t deferred_dropped;
+
+#ifdef CONFIG_PRINTK_DEFERRED_THREAD
+static K_SEM_DEFINE(deferred_sem, 0, 1);
+#endif
+
+/* Format a record stored by printk_deferred() */
+static void pkg_out(out_func_t out, void *ctx, const u8_t *pkg)
+{
+	struct arg_src src = {
+		.pkg = pkg + sizeof(const char *),
+	};
+
+	prf(out, ctx, UNALIGNED_GET((const char **)pkg), &src);
+}
+
+void z_printk_deferred(const void *pkg, size_t size)
+{
+	k_spinlock_key_t key;
+	int ret;
+
+#ifdef CONFIG_USERSPACE
+	if (_is_user_context()) {
+		struct buf_out_context ctx = { 0 };
+
+		pkg_out(buf_char_out, &ctx, pkg);
+		if (ctx.buf_count) {
+			buf_flush(&ctx);
+		}
+		return;
+	}
+#endif
+
+	key = k_spin_lock(&deferred_lock);
+	ret = ring_buf_item_put(&z_printk_deferred_buf, 0, 0, (u32_t *)pkg,
+				size / sizeof(u32_t));
+	k_spin_unlock(&deferred_lock, key);
+
+	if (ret != 0) {
+		atomic_inc(&deferred_dropped);
+		return;
+	}
+
+#ifdef CONFIG_PRINTK_DEFERRED_THREAD
+	k_sem_give(&deferred_sem);
+#endif
+}
+
+bool printk_deferred_process(void)
+{
+	u32_t pkg[Z_PRINTK_DEFERRED_MAX_SIZE / sizeof(u32_t)];
+	u8_t size32 = ARRAY_SIZE(pkg);
+	struct out_context ctx = { 0 };
+	atomic_val_t dropped;
+	u16_t type;
+	u8_t value;
+	int ret;
+
+	if (!atomic_cas(&deferred_busy, 0, 1)) {
+		return false;
+	}
+
+	dropped = atomic_set(&deferred_dropped, 0);
+	if (dropped != 0) {
+		struct __packed {
+			const char *fmt;
+			unsigned int count;
+		} notice = { "--- %u messages dropped ---\n", dropped };
+
+		pkg_out(char_out, &ctx, (const u8_t *)&notice);
+	}
+
+	ret = ring_buf_item_get(&z_printk_deferred_buf, &type, &value, pkg,
+				&size32);
+	if (ret == 0) {
+		pkg_out(char_out, &ctx, (const u8_t *)pkg);
+	}
+
+	atomic_clear(&deferred_busy);
+
+	return ret == 0 || dropped != 0;
+}
+
+#ifdef CONFIG_PRINTK_DEFERRED_THREAD
+static void deferred_thread(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		k_sem_take(&deferred_sem, K_FOREVER);
+		while (printk_deferred_process()) {
+		}
+	}
+}
+
+K_THREAD_DEFINE(printk_deferred_thread,
+		CONFIG_PRINTK_DEFERRED_THREAD_STACK_SIZE, deferred_thread,
+		NULL, NULL, NULL, K_LOWEST_APPLICATION_THREAD_PRIO, 0, 0);
+#endif /* CONFIG_PRINTK_DEFERRED_THREAD */
+#endif /* CONFIG_PRINTK_DEFERRED */
 #endif /* CONFIG_PRINTK */
 
 /**
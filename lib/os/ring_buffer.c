@@ -21,12 +21,47 @@ struct ring_element {
 	u32_t  value  :8;  /**< Room for small integral values */
 };
 
+/* The producer only ever writes the tail indexes and the consumer only
+ * ever writes the head indexes, so one of each can run concurrently
+ * without a lock: each side reads the other side's index before touching
+ * the data, and publishes its own index only once it is done with it.
+ */
+#ifdef CONFIG_ATOMIC_OPERATIONS_BUILTIN
+static inline u32_t idx_load(u32_t *idx)
+{
+	return __atomic_load_n(idx, __ATOMIC_ACQUIRE);
+}
+
+static inline void idx_store(u32_t *idx, u32_t val)
+{
+	__atomic_store_n(idx, val, __ATOMIC_RELEASE);
+}
+#else
+/* Targets without atomic builtins are uniprocessor, where only the
+ * compiler can reorder accesses with respect to an interrupt.
+ */
+static inline u32_t idx_load(u32_t *idx)
+{
+	u32_t val = *(volatile u32_t *)idx;
+
+	compiler_barrier();
+	return val;
+}
+
+static inline void idx_store(u32_t *idx, u32_t val)
+{
+	compiler_barrier();
+	*(volatile u32_t *)idx = val;
+}
+#endif
+
 int ring_buf_item_put(struct ring_buf *buf, u16_t type, u8_t value,
 		      u32_t *data, u8_t size32)
 {
 	u32_t i, space, index, rc;
 
-	space = ring_buf_space_get(buf);
+	space = z_ring_buf_custom_space_get(buf->size, idx_load(&buf->head),
+					    buf->tail);
 	if (space >= (size32 + 1)) {
 		struct ring_element *header =
 			(struct ring_element *)&buf->buf.buf32[buf->tail];
@@ -39,13 +74,15 @@ int ring_buf_item_put(struct ring_buf *buf, u16_t type, u8_t value,
 				index = (i + buf->tail + 1) & buf->mask;
 				buf->buf.buf32[index] = data[i];
 			}
-			buf->tail = (buf->tail + size32 + 1) & buf->mask;
+			idx_store(&buf->tail,
+				  (buf->tail + size32 + 1) & buf->mask);
 		} else {
 			for (i = 0U; i < size32; ++i) {
 				index = (i + buf->tail + 1) % buf->size;
 				buf->buf.buf32[index] = data[i];
 			}
-			buf->tail = (buf->tail + size32 + 1) % buf->size;
+			idx_store(&buf->tail,
+				  (buf->tail + size32 + 1) % buf->size);
 		}
 		rc = 0U;
 	} else {
@@ -62,7 +99,7 @@ int ring_buf_item_get(struct ring_buf *buf, u16_t *type, u8_t *value,
 	struct ring_element *header;
 	u32_t i, index;
 
-	if (ring_buf_is_empty(buf)) {
+	if (buf->head == idx_load(&buf->tail)) {
 		return -EAGAIN;
 	}
 
@@ -82,13 +119,15 @@ int ring_buf_item_get(struct ring_buf *buf, u16_t *type, u8_t *value,
 			index = (i + buf->head + 1) & buf->mask;
 			data[i] = buf->buf.buf32[index];
 		}
-		buf->head = (buf->head + header->length + 1) & buf->mask;
+		idx_store(&buf->head,
+			  (buf->head + header->length + 1) & buf->mask);
 	} else {
 		for (i = 0U; i < header->length; ++i) {
 			index = (i + buf->head + 1) % buf->size;
 			data[i] = buf->buf.buf32[index];
 		}
-		buf->head = (buf->head + header->length + 1) % buf->size;
+		idx_store(&buf->head,
+			  (buf->head + header->length + 1) % buf->size);
 	}
 
 	return 0;
@@ -110,7 +149,7 @@ u32_t ring_buf_put_claim(struct ring_buf *buf, u8_t **data, u32_t size)
 {
 	u32_t space, trail_size, allocated;
 
-	space = z_ring_buf_custom_space_get(buf->size, buf->head,
+	space = z_ring_buf_custom_space_get(buf->size, idx_load(&buf->head),
 					    buf->misc.byte_mode.tmp_tail);
 
 	/* Limit requested size to available size. */
@@ -129,12 +168,17 @@ u32_t ring_buf_put_claim(struct ring_buf *buf, u8_t **data, u32_t size)
 
 int ring_buf_put_finish(struct ring_buf *buf, u32_t size)
 {
-	if (size > ring_buf_space_get(buf)) {
+	u32_t tail;
+
+	if (size > z_ring_buf_custom_space_get(buf->size,
+					       idx_load(&buf->head),
+					       buf->tail)) {
 		return -EINVAL;
 	}
 
-	buf->tail = wrap(buf->tail + size, buf->size);
-	buf->misc.byte_mode.tmp_tail = buf->tail;
+	tail = wrap(buf->tail + size, buf->size);
+	buf->misc.byte_mode.tmp_tail = tail;
+	idx_store(&buf->tail, tail);
 
 	return 0;
 }
@@ -167,7 +211,7 @@ u32_t ring_buf_get_claim(struct ring_buf *buf, u8_t **data, u32_t size)
 	space = (buf->size - 1) -
 		z_ring_buf_custom_space_get(buf->size,
 					    buf->misc.byte_mode.tmp_head,
-					    buf->tail);
+					    idx_load(&buf->tail));
 	trail_size = buf->size - buf->misc.byte_mode.tmp_head;
 
 	/* Limit requested size to available size. */
@@ -185,14 +229,18 @@ u32_t ring_buf_get_claim(struct ring_buf *buf, u8_t **data, u32_t size)
 
 int ring_buf_get_finish(struct ring_buf *buf, u32_t size)
 {
-	u32_t allocated = (buf->size - 1) - ring_buf_space_get(buf);
+	u32_t head;
+	u32_t allocated = (buf->size - 1) -
+		z_ring_buf_custom_space_get(buf->size, buf->head,
+					    idx_load(&buf->tail));
 
 	if (size > allocated) {
 		return -EINVAL;
 	}
 
-	buf->head = wrap(buf->head + size, buf->size);
-	buf->misc.byte_mode.tmp_head = buf->head;
+	head = wrap(buf->head + size, buf->size);
+	buf->misc.byte_mode.tmp_head = head;
+	idx_store(&buf->head, head);
 
 	return 0;
 }
@@ -217,3 +265,42 @@ u32_t ring_buf_get(struct ring_buf *buf, u8_t *data, u32_t size)
 
 	return total_size;
 }
+
+u32_t ring_buf_mpsc_put_claim(struct ring_buf_mpsc *mbuf, u8_t **data,
+			      u32_t size)
+{
+	k_spinlock_key_t key = k_spin_lock(&mbuf->lock);
+
+	mbuf->key = key;
+
+	return ring_buf_put_claim(&mbuf->rb, data, size);
+}
+
+int ring_buf_mpsc_put_finish(struct ring_buf_mpsc *mbuf, u32_t size)
+{
+	k_spinlock_key_t key = mbuf->key;
+	int ret;
+
+	ret = ring_buf_put_finish(&mbuf->rb, size);
+	if (ret != 0) {
+		/* Drop the claim, the next producer starts afresh */
+		mbuf->rb.misc.byte_mode.tmp_tail = mbuf->rb.tail;
+	}
+
+	k_spin_unlock(&mbuf->lock, key);
+
+	return ret;
+}
+
+u32_t ring_buf_mpsc_put(struct ring_buf_mpsc *mbuf, const u8_t *data,
+			u32_t size)
+{
+	k_spinlock_key_t key = k_spin_lock(&mbuf->lock);
+	u32_t total_size;
+
+	total_size = ring_buf_put(&mbuf->rb, data, size);
+
+	k_spin_unlock(&mbuf->lock, key);
+
+	return total_size;
+}
@@ -88,6 +88,7 @@ kobjects = OrderedDict([
     ("k_pipe", (None, False)),
     ("k_queue", (None, False)),
     ("k_poll_signal", (None, False)),
+    ("k_poll_set", (None, False)),
     ("k_sem", (None, False)),
     ("k_stack", (None, False)),
     ("k_thread", (None, False)),
@@ -52,6 +52,55 @@ static int cmd_kernel_cycles(const struct shell *shell,
 
 #if defined(CONFIG_INIT_STACKS) && defined(CONFIG_THREAD_STACK_INFO) && \
 	defined(CONFIG_THREAD_MONITOR)
+#ifdef CONFIG_THREAD_RUNTIME_STATS
+static u64_t rt_stats_total_cycles;
+
+static void shell_rt_stats_total(const struct k_thread *thread,
+				 void *user_data)
+{
+	struct k_thread_runtime_stats stats;
+
+	ARG_UNUSED(user_data);
+
+	(void)k_thread_runtime_stats_get((k_tid_t)thread, &stats);
+	rt_stats_total_cycles += stats.execution_cycles;
+}
+
+static void shell_rt_stats_dump(const struct shell *shell,
+				struct k_thread *thread)
+{
+	struct k_thread_runtime_stats stats;
+	unsigned int pcnt = 0U;
+
+	(void)k_thread_runtime_stats_get(thread, &stats);
+
+	if (rt_stats_total_cycles != 0U) {
+		pcnt = (unsigned int)((stats.execution_cycles * 100U) /
+				      rt_stats_total_cycles);
+	}
+
+	shell_print(shell,
+		    "\tcpu usage: %u %%, switches: %u, slices expired: %u",
+		    pcnt, stats.switches, stats.slice_expirations);
+
+	shell_fprintf(shell, SHELL_NORMAL, "\tready latency (us):");
+	for (int i = 0; i < K_THREAD_LATENCY_BUCKETS; i++) {
+		if (stats.latency_hist[i] == 0U) {
+			continue;
+		}
+
+		if (i < K_THREAD_LATENCY_BUCKETS - 1) {
+			shell_fprintf(shell, SHELL_NORMAL, " <%u: %u",
+				      1U << i, stats.latency_hist[i]);
+		} else {
+			shell_fprintf(shell, SHELL_NORMAL, " >=%u: %u",
+				      1U << (i - 1), stats.latency_hist[i]);
+		}
+	}
+	shell_fprintf(shell, SHELL_NORMAL, "\n");
+}
+#endif
+
 static void shell_tdata_dump(const struct k_thread *cthread, void *user_data)
 {
 	struct k_thread *thread = (struct k_thread *)cthread;
@@ -71,8 +120,11 @@ static void shell_tdata_dump(const struct k_thread *cthread, void *user_data)
 	shell_print(shell, "\toptions: 0x%x, priority: %d timeout: %d",
 		      thread->base.user_options,
 		      thread->base.prio,
-		      thread->base.timeout.dticks);
+		      (s32_t)k_thread_timeout_remaining_ticks(thread));
 	shell_print(shell, "\tstate: %s", k_thread_state_str(thread));
+#ifdef CONFIG_THREAD_RUNTIME_STATS
+	shell_rt_stats_dump(shell, thread);
+#endif
 
 	ret = k_thread_stack_space_get(thread, &unused);
 	if (ret) {
@@ -98,6 +150,10 @@ static int cmd_kernel_threads(const struct shell *shell,
 
 	shell_print(shell, "Scheduler: %u since last call", z_clock_elapsed());
 	shell_print(shell, "Threads:");
+#ifdef CONFIG_THREAD_RUNTIME_STATS
+	rt_stats_total_cycles = 0U;
+	k_thread_foreach(shell_rt_stats_total, NULL);
+#endif
 	k_thread_foreach(shell_tdata_dump, (void *)shell);
 	return 0;
 }
@@ -171,6 +227,59 @@ static int cmd_kernel_stacks(const struct shell *shell,
 }
 #endif
 
+#if defined(CONFIG_SYS_HEAP_RUNTIME_STATS)
+static int cmd_kernel_heaps(const struct shell *shell,
+			    size_t argc, char **argv)
+{
+	struct sys_heap_runtime_stats stats;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	shell_print(shell, "Heaps:");
+
+	Z_STRUCT_SECTION_FOREACH(k_heap, h) {
+		k_heap_runtime_stats_get(h, &stats);
+
+		shell_print(shell,
+			"%p free %zu\tallocated %zu\tpeak %zu\t"
+			"largest free %zu in %zu chunks (%u %% fragmented)",
+			h, stats.free_bytes, stats.allocated_bytes,
+			stats.max_allocated_bytes, stats.largest_free_bytes,
+			stats.free_chunks, stats.fragmentation);
+	}
+
+	return 0;
+}
+#endif
+
+#if defined(CONFIG_SPINLOCK_STATS)
+static int cmd_kernel_locks(const struct shell *shell,
+			    size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	shell_print(shell, "Spinlocks:");
+
+	Z_STRUCT_SECTION_FOREACH(z_spinlock_stats_entry, e) {
+		struct k_spinlock *l = e->lock;
+		u32_t acquired = l->acquired;
+		u32_t contended = l->contended;
+		u32_t spins = l->spins;
+
+		shell_print(shell,
+			"%-16s acquired %u\tcontended %u (%u %%)\t"
+			"spins %u (%u per contention)",
+			e->name, acquired, contended,
+			acquired ? (u32_t)((u64_t)contended * 100U / acquired) :
+			0U, spins, contended ? spins / contended : 0U);
+	}
+
+	return 0;
+}
+#endif
+
 #if defined(CONFIG_REBOOT)
 static int cmd_kernel_reboot_warm(const struct shell *shell,
 				  size_t argc, char **argv)
@@ -199,6 +308,13 @@ SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel_reboot,
 
 SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel,
 	SHELL_CMD(cycles, NULL, "Kernel cycles.", cmd_kernel_cycles),
+#if defined(CONFIG_SYS_HEAP_RUNTIME_STATS)
+	SHELL_CMD(heaps, NULL, "List k_heap usage.", cmd_kernel_heaps),
+#endif
+#if defined(CONFIG_SPINLOCK_STATS)
+	SHELL_CMD(locks, NULL, "List kernel spinlock contention.",
+		  cmd_kernel_locks),
+#endif
 #if defined(CONFIG_REBOOT)
 	SHELL_CMD(reboot, &sub_kernel_reboot, "Reboot.", NULL),
 #endif
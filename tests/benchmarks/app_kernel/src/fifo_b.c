@@ -10,6 +10,67 @@
 
 #ifdef FIFO_BENCH
 
+/* messages moved per k_msgq_put_batch()/get_batch() call */
+#define FIFO_BATCH 16
+
+/**
+ *
+ * @brief Batch and in-place queue transfer speed test
+ *
+ * Moves the same number of 4 byte messages as the single message test,
+ * FIFO_BATCH at a time, so that the per message figures compare
+ * directly with it.
+ *
+ * @return N/A
+ */
+static void queue_batch_test(void)
+{
+	u32_t et; /* elapsed time */
+	u32_t batch[FIFO_BATCH];
+	void *slot;
+	int i, n;
+
+	(void)memcpy(batch, data_bench, sizeof(batch));
+
+	et = BENCH_START();
+	for (i = 0; i < NR_OF_FIFO_RUNS; i += n) {
+		n = k_msgq_put_batch(&DEMOQX4, batch,
+				     MIN(FIFO_BATCH, NR_OF_FIFO_RUNS - i),
+				     K_FOREVER);
+	}
+	et = TIME_STAMP_DELTA_GET(et);
+	check_result();
+
+	PRINT_F(output_file, FORMAT, "enqueue 4 bytes msg in FIFO, batched",
+			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
+
+	et = BENCH_START();
+	for (i = 0; i < NR_OF_FIFO_RUNS; i += n) {
+		n = k_msgq_get_batch(&DEMOQX4, batch, FIFO_BATCH, K_FOREVER);
+	}
+	et = TIME_STAMP_DELTA_GET(et);
+	check_result();
+
+	PRINT_F(output_file, FORMAT, "dequeue 4 bytes msg in FIFO, batched",
+			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
+
+	et = BENCH_START();
+	for (i = 0; i < NR_OF_FIFO_RUNS; i += n) {
+		n = k_msgq_put_claim(&DEMOQX4, &slot,
+				     MIN(FIFO_BATCH, NR_OF_FIFO_RUNS - i));
+		(void)memcpy(slot, batch, n * sizeof(batch[0]));
+		k_msgq_put_commit(&DEMOQX4, n);
+	}
+	et = TIME_STAMP_DELTA_GET(et);
+	check_result();
+
+	PRINT_F(output_file, FORMAT,
+			"enqueue 4 bytes msg in FIFO, claim/commit",
+			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
+
+	k_msgq_purge(&DEMOQX4);
+}
+
 /**
  *
  * @brief Queue transfer speed test
@@ -61,6 +122,8 @@ void queue_test(void)
 	PRINT_F(output_file, FORMAT, "dequeue 4 bytes msg in FIFO",
 			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
 
+	queue_batch_test();
+
 	k_sem_give(&STARTRCV);
 
 	et = BENCH_START();
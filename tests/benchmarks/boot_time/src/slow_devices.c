@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Devices with slow init functions
+ *
+ * Each device waits SLOW_INIT_MS for its hardware in its init function.
+ * "SLOW_MODEM" is attached through "SLOW_UART" and depends on it, the
+ * others are independent.
+ */
+
+#include <zephyr.h>
+#include <device.h>
+#include <init.h>
+
+#ifdef CONFIG_BOOT_TIME_SLOW_DEVICES
+
+#define SLOW_INIT_MS 20
+
+static int slow_init(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	k_msleep(SLOW_INIT_MS);
+
+	return 0;
+}
+
+DEVICE_INIT(slow_phy, "SLOW_PHY", slow_init, NULL, NULL,
+	    POST_KERNEL, 60);
+DEVICE_INIT(slow_flash, "SLOW_FLASH", slow_init, NULL, NULL,
+	    POST_KERNEL, 60);
+DEVICE_INIT(slow_uart, "SLOW_UART", slow_init, NULL, NULL,
+	    POST_KERNEL, 60);
+DEVICE_INIT(slow_modem, "SLOW_MODEM", slow_init, NULL, NULL,
+	    POST_KERNEL, 61);
+
+INIT_PARALLEL("SLOW_PHY");
+INIT_PARALLEL("SLOW_FLASH");
+INIT_PARALLEL("SLOW_UART");
+INIT_PARALLEL("SLOW_MODEM", "SLOW_UART");
+
+#endif /* CONFIG_BOOT_TIME_SLOW_DEVICES */
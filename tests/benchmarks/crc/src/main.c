@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <sys/crc.h>
+
+/* CRC throughput microbenchmark, see README.rst */
+
+#define BUF_SIZE 4096
+#define ROUNDS 16
+
+static u8_t buf[BUF_SIZE];
+
+/* Keeps the results alive so the calls can't be optimized out */
+static volatile u32_t sink;
+
+enum crc_fn {
+	CRC32_IEEE,
+	CRC16_CCITT,
+	CRC16_ITU_T,
+	CRC8_CCITT,
+	CRC16_GENERIC,
+};
+
+static const char * const names[] = {
+	[CRC32_IEEE] = "crc32_ieee",
+	[CRC16_CCITT] = "crc16_ccitt",
+	[CRC16_ITU_T] = "crc16_itu_t",
+	[CRC8_CCITT] = "crc8_ccitt",
+	[CRC16_GENERIC] = "crc16",
+};
+
+static u32_t run(enum crc_fn fn)
+{
+	u32_t crc = 0U;
+
+	switch (fn) {
+	case CRC32_IEEE:
+		crc = crc32_ieee_update(crc, buf, sizeof(buf));
+		break;
+	case CRC16_CCITT:
+		crc = crc16_ccitt(0xffff, buf, sizeof(buf));
+		break;
+	case CRC16_ITU_T:
+		crc = crc16_itu_t(0, buf, sizeof(buf));
+		break;
+	case CRC8_CCITT:
+		crc = crc8_ccitt(CRC8_CCITT_INITIAL_VALUE, buf, sizeof(buf));
+		break;
+	case CRC16_GENERIC:
+		crc = crc16(buf, sizeof(buf), 0x1021, 0xffff, false);
+		break;
+	}
+
+	return crc;
+}
+
+static const char *crc32_variant(void)
+{
+	if (IS_ENABLED(CONFIG_CRC32_SW_SLICE_BY_8)) {
+		return "slice-by-8";
+	} else if (IS_ENABLED(CONFIG_CRC32_SW_BYTE)) {
+		return "byte";
+	} else if (IS_ENABLED(CONFIG_CRC32_SW_NIBBLE)) {
+		return "nibble";
+	}
+
+	return "bitwise";
+}
+
+void main(void)
+{
+	const char *crc16_variant =
+		IS_ENABLED(CONFIG_CRC16_SW_TABLE) ? "table" : "shift";
+
+	for (int i = 0; i < sizeof(buf); i++) {
+		buf[i] = (u8_t)(i * 7 + (i >> 8));
+	}
+
+	printk("crc32 implementation: %s, crc16 implementation: %s\n",
+	       crc32_variant(), crc16_variant);
+
+	for (int fn = 0; fn < ARRAY_SIZE(names); fn++) {
+		u32_t t0, cycles, per_kib;
+		u64_t kib_s;
+
+		/* Warm up the caches */
+		sink = run(fn);
+
+		t0 = k_cycle_get_32();
+		for (int r = 0; r < ROUNDS; r++) {
+			sink = run(fn);
+		}
+		cycles = MAX(k_cycle_get_32() - t0, 1U);
+
+		per_kib = cycles / (ROUNDS * BUF_SIZE / 1024);
+		kib_s = (u64_t)ROUNDS * (BUF_SIZE / 1024) *
+			sys_clock_hw_cycles_per_sec() / cycles;
+
+		printk("%-12s %-10s cycles/KiB %8u KiB/s %8u\n", names[fn],
+		       fn == CRC32_IEEE ? crc32_variant() :
+		       (fn == CRC16_CCITT || fn == CRC16_ITU_T) ?
+		       crc16_variant : "-", per_kib, (u32_t)kib_s);
+	}
+
+	printk("fin\n");
+}
@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <string.h>
+#include <data/json.h>
+
+/* JSON parser and encoder microbenchmark, see README.rst */
+
+#define ROUNDS 64
+#define MAX_SENSORS 8
+#define CHUNK 64
+
+/* json_obj_parse() sizes array elements by rounding each field up to
+ * the alignment of the enclosing structure, so keep it pointer sized.
+ */
+struct sensor {
+	const char *name;
+	int value;
+};
+
+struct report {
+	const char *device;
+	int timestamp;
+	bool online;
+	struct sensor sensors[MAX_SENSORS];
+	size_t sensors_len;
+};
+
+static const struct json_obj_descr sensor_descr[] = {
+	JSON_OBJ_DESCR_PRIM(struct sensor, name, JSON_TOK_STRING),
+	JSON_OBJ_DESCR_PRIM(struct sensor, value, JSON_TOK_NUMBER),
+};
+
+static const struct json_obj_descr report_descr[] = {
+	JSON_OBJ_DESCR_PRIM(struct report, device, JSON_TOK_STRING),
+	JSON_OBJ_DESCR_PRIM(struct report, timestamp, JSON_TOK_NUMBER),
+	JSON_OBJ_DESCR_PRIM(struct report, online, JSON_TOK_TRUE),
+	JSON_OBJ_DESCR_OBJ_ARRAY(struct report, sensors, MAX_SENSORS,
+				 sensors_len, sensor_descr,
+				 ARRAY_SIZE(sensor_descr)),
+};
+
+static const char document[] =
+	"{\"device\":\"urn:dev:ops:32473-zephyr-bench\","
+	"\"timestamp\":1589371264,\"online\":true,"
+	"\"sensors\":["
+	"{\"name\":\"temperature\",\"value\":2315},"
+	"{\"name\":\"humidity\",\"value\":4410},"
+	"{\"name\":\"pressure\",\"value\":101325},"
+	"{\"name\":\"light\",\"value\":730},"
+	"{\"name\":\"voltage\",\"value\":3291},"
+	"{\"name\":\"current\",\"value\":-120}"
+	"]}";
+
+static char work[sizeof(document)];
+static char out[sizeof(document) + 64];
+static struct report report;
+
+/* The streaming parser only keeps the current value, so the callback
+ * copies strings out where json_obj_parse() leaves them in place.
+ */
+static char strings[MAX_SENSORS + 1][48];
+
+static const char *to_str(const struct json_stream_token *token, int i)
+{
+	if (token->value_len >= sizeof(strings[0])) {
+		return NULL;
+	}
+
+	memcpy(strings[i], token->value, token->value_len);
+	strings[i][token->value_len] = '\0';
+
+	return strings[i];
+}
+
+/* Token values are not NUL terminated */
+static int to_int(const struct json_stream_token *token)
+{
+	bool neg = token->value_len && token->value[0] == '-';
+	int n = 0;
+
+	for (size_t i = neg; i < token->value_len; i++) {
+		n = n * 10 + token->value[i] - '0';
+	}
+
+	return neg ? -n : n;
+}
+
+static int on_token(const struct json_stream_token *token, void *user_data)
+{
+	struct report *r = user_data;
+	struct sensor *s;
+
+	if (token->depth == 1) {
+		if (token->type == JSON_TOK_LIST_START) {
+			r->sensors_len = 0;
+			return 0;
+		}
+
+		if (token->key_len == 6 && !memcmp(token->key, "device", 6)) {
+			r->device = to_str(token, MAX_SENSORS);
+		} else if (token->key_len == 6 &&
+			   !memcmp(token->key, "online", 6)) {
+			r->online = token->type == JSON_TOK_TRUE;
+		} else if (token->key_len == 9 &&
+			   !memcmp(token->key, "timestamp", 9)) {
+			r->timestamp = to_int(token);
+		}
+	} else if (token->depth == 2 && token->type == JSON_TOK_OBJECT_START) {
+		if (r->sensors_len == MAX_SENSORS) {
+			return -ENOSPC;
+		}
+		r->sensors_len++;
+	} else if (token->depth == 3) {
+		s = &r->sensors[r->sensors_len - 1];
+
+		if (token->key_len == 4 && !memcmp(token->key, "name", 4)) {
+			s->name = to_str(token, r->sensors_len - 1);
+		} else if (token->key_len == 5 &&
+			   !memcmp(token->key, "value", 5)) {
+			s->value = to_int(token);
+		}
+	}
+
+	return 0;
+}
+
+static int parse_descr(void)
+{
+	/* json_obj_parse() modifies the document */
+	memcpy(work, document, sizeof(document));
+
+	return json_obj_parse(work, sizeof(document) - 1, report_descr,
+			      ARRAY_SIZE(report_descr), &report);
+}
+
+static int parse_stream(size_t chunk)
+{
+	struct json_stream stream;
+	char buf[64];
+	size_t len = sizeof(document) - 1;
+	int ret = 0;
+
+	/* Same copy as parse_descr(), as if read from a socket */
+	memcpy(work, document, sizeof(document));
+
+	json_stream_init(&stream, buf, sizeof(buf), on_token, &report);
+	for (size_t pos = 0; pos < len && ret == 0; pos += chunk) {
+		ret = json_stream_feed(&stream, work + pos,
+				       MIN(chunk, len - pos));
+	}
+
+	return ret ? ret : json_stream_finish(&stream);
+}
+
+static bool check_report(void)
+{
+	return report.sensors_len == 6 && report.timestamp == 1589371264 &&
+	       report.online && report.sensors[2].name &&
+	       !strcmp(report.sensors[2].name, "pressure") &&
+	       report.sensors[2].value == 101325 &&
+	       report.sensors[5].value == -120 && report.device &&
+	       !strcmp(report.device, "urn:dev:ops:32473-zephyr-bench");
+}
+
+static u32_t bench_parse(size_t chunk)
+{
+	u32_t t0, t1;
+	int ret, err = 0;
+
+	memset(&report, 0, sizeof(report));
+
+	t0 = k_cycle_get_32();
+	for (int i = 0; i < ROUNDS; i++) {
+		ret = chunk ? parse_stream(chunk) : parse_descr();
+		err = MIN(err, ret);
+	}
+	t1 = k_cycle_get_32();
+
+	if (err < 0 || !check_report()) {
+		printk("parse error %d (chunk %u)\n", err, (u32_t)chunk);
+	}
+
+	return (t1 - t0) / ROUNDS;
+}
+
+static u32_t bench_encode(void)
+{
+	u32_t t0, t1;
+	int ret, err = 0;
+
+	t0 = k_cycle_get_32();
+	for (int i = 0; i < ROUNDS; i++) {
+		ret = json_obj_encode_buf(report_descr,
+					   ARRAY_SIZE(report_descr), &report,
+					   out, sizeof(out));
+		err = MIN(err, ret);
+	}
+	t1 = k_cycle_get_32();
+
+	if (err < 0 || strcmp(out, document)) {
+		printk("encode error %d: %s\n", err, out);
+	}
+
+	return (t1 - t0) / ROUNDS;
+}
+
+void main(void)
+{
+	u32_t descr = bench_parse(0);
+	u32_t stream = bench_parse(sizeof(document));
+	u32_t chunked = bench_parse(CHUNK);
+
+	printk("document %u bytes\n", (u32_t)sizeof(document) - 1);
+	printk("parse descr %6u stream %6u stream/%u %6u cycles\n",
+	       descr, stream, CHUNK, chunked);
+	printk("encode buf %6u cycles\n", bench_encode());
+	printk("fin\n");
+}
@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <string.h>
+#include <sys/types.h>
+
+/* Minimal libc string function microbenchmark, see README.rst */
+
+#define MAX_SIZE 4096
+#define BYTES_PER_SIZE (64 * 1024)
+
+enum string_fn {
+	MEMCPY,
+	MEMSET,
+	MEMCMP,
+	MEMCHR,
+	STRLEN,
+	STRCMP,
+};
+
+static const char * const names[] = {
+	[MEMCPY] = "memcpy",
+	[MEMSET] = "memset",
+	[MEMCMP] = "memcmp",
+	[MEMCHR] = "memchr",
+	[STRLEN] = "strlen",
+	[STRCMP] = "strcmp",
+};
+
+static const size_t sizes[] = { 8, 64, 512, MAX_SIZE };
+
+/* Offsets of the two buffers from a word boundary */
+static const struct {
+	u8_t dst;
+	u8_t src;
+} offsets[] = {
+	{ 0, 0 },
+	{ 1, 1 },
+	{ 0, 1 },
+	{ 3, 0 },
+};
+
+static u8_t dst_buf[MAX_SIZE + 16] __aligned(8);
+static u8_t src_buf[MAX_SIZE + 16] __aligned(8);
+
+/* Keeps the results alive so the calls can't be optimized out */
+static volatile uintptr_t sink;
+
+/* The byte at a time versions the minimal libc used before */
+
+static __attribute__((noinline))
+void *ref_memcpy(void *d, const void *s, size_t n)
+{
+	unsigned char *d_byte = (unsigned char *)d;
+	const unsigned char *s_byte = (const unsigned char *)s;
+	const uintptr_t mask = sizeof(mem_word_t) - 1;
+
+	if ((((uintptr_t)d ^ (uintptr_t)s_byte) & mask) == 0) {
+		while (((uintptr_t)d_byte) & mask) {
+			if (n == 0) {
+				return d;
+			}
+			*(d_byte++) = *(s_byte++);
+			n--;
+		};
+
+		mem_word_t *d_word = (mem_word_t *)d_byte;
+		const mem_word_t *s_word = (const mem_word_t *)s_byte;
+
+		while (n >= sizeof(mem_word_t)) {
+			*(d_word++) = *(s_word++);
+			n -= sizeof(mem_word_t);
+		}
+
+		d_byte = (unsigned char *)d_word;
+		s_byte = (unsigned char *)s_word;
+	}
+
+	while (n > 0) {
+		*(d_byte++) = *(s_byte++);
+		n--;
+	}
+
+	return d;
+}
+
+static __attribute__((noinline))
+void *ref_memset(void *buf, int c, size_t n)
+{
+	unsigned char *d_byte = (unsigned char *)buf;
+	unsigned char c_byte = (unsigned char)c;
+
+	while (((uintptr_t)d_byte) & (sizeof(mem_word_t) - 1)) {
+		if (n == 0) {
+			return buf;
+		}
+		*(d_byte++) = c_byte;
+		n--;
+	};
+
+	mem_word_t *d_word = (mem_word_t *)d_byte;
+	mem_word_t c_word = (mem_word_t)c_byte;
+
+	c_word |= c_word << 8;
+	c_word |= c_word << 16;
+#if Z_MEM_WORD_T_WIDTH > 32
+	c_word |= c_word << 32;
+#endif
+
+	while (n >= sizeof(mem_word_t)) {
+		*(d_word++) = c_word;
+		n -= sizeof(mem_word_t);
+	}
+
+	d_byte = (unsigned char *)d_word;
+
+	while (n > 0) {
+		*(d_byte++) = c_byte;
+		n--;
+	}
+
+	return buf;
+}
+
+static __attribute__((noinline))
+int ref_memcmp(const void *m1, const void *m2, size_t n)
+{
+	const char *c1 = m1;
+	const char *c2 = m2;
+
+	if (!n) {
+		return 0;
+	}
+
+	while ((--n > 0) && (*c1 == *c2)) {
+		c1++;
+		c2++;
+	}
+
+	return *c1 - *c2;
+}
+
+static __attribute__((noinline))
+void *ref_memchr(const void *s, int c, size_t n)
+{
+	if (n != 0) {
+		const unsigned char *p = s;
+
+		do {
+			if (*p++ == (unsigned char)c) {
+				return ((void *)(p - 1));
+			}
+
+		} while (--n != 0);
+	}
+
+	return NULL;
+}
+
+static __attribute__((noinline))
+size_t ref_strlen(const char *s)
+{
+	size_t n = 0;
+
+	while (*s != '\0') {
+		s++;
+		n++;
+	}
+
+	return n;
+}
+
+static __attribute__((noinline))
+int ref_strcmp(const char *s1, const char *s2)
+{
+	while ((*s1 == *s2) && (*s1 != '\0')) {
+		s1++;
+		s2++;
+	}
+
+	return *s1 - *s2;
+}
+
+static uintptr_t run(enum string_fn fn, bool ref, u8_t *dst, u8_t *src,
+		     size_t n)
+{
+	switch (fn) {
+	case MEMCPY:
+		return (uintptr_t)(ref ? ref_memcpy : memcpy)(dst, src, n);
+	case MEMSET:
+		return (uintptr_t)(ref ? ref_memset : memset)(dst, 0x5a, n);
+	case MEMCMP:
+		return (ref ? ref_memcmp : memcmp)(dst, src, n);
+	case MEMCHR:
+		return (uintptr_t)(ref ? ref_memchr : memchr)(src, 'z', n);
+	case STRLEN:
+		return (ref ? ref_strlen : strlen)((char *)src);
+	case STRCMP:
+		return (ref ? ref_strcmp : strcmp)((char *)dst, (char *)src);
+	}
+
+	return 0;
+}
+
+static u32_t measure(enum string_fn fn, bool ref, u8_t *dst, u8_t *src,
+		     size_t n)
+{
+	u32_t rounds = BYTES_PER_SIZE / n;
+	u32_t t0, t1;
+
+	t0 = k_cycle_get_32();
+	for (u32_t i = 0; i < rounds; i++) {
+		sink = run(fn, ref, dst, src, n);
+	}
+	t1 = k_cycle_get_32();
+
+	return (t1 - t0) / rounds;
+}
+
+static void bench(enum string_fn fn)
+{
+	for (int i = 0; i < ARRAY_SIZE(sizes); i++) {
+		for (int j = 0; j < ARRAY_SIZE(offsets); j++) {
+			size_t n = sizes[i];
+			u8_t *dst = dst_buf + offsets[j].dst;
+			u8_t *src = src_buf + offsets[j].src;
+			u32_t libc, ref;
+
+			/* Equal strings of n - 1 characters, so that the
+			 * comparisons and searches go through all of them
+			 */
+			(void)ref_memset(src, 'a', n - 1);
+			src[n - 1] = '\0';
+			(void)ref_memcpy(dst, src, n);
+
+			libc = measure(fn, false, dst, src, n);
+			ref = measure(fn, true, dst, src, n);
+
+			printk("%-7s %5u %u/%u  libc %6u  ref %6u cycles\n",
+			       names[fn], (u32_t)n, offsets[j].dst,
+			       offsets[j].src, libc, ref);
+		}
+	}
+}
+
+void main(void)
+{
+	for (int fn = 0; fn < ARRAY_SIZE(names); fn++) {
+		bench(fn);
+	}
+
+	printk("fin\n");
+}
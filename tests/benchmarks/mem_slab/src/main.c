@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+
+/* Memory slab throughput benchmark, see README.rst */
+
+#define BLK_SIZE 32
+#define BURST 4
+#define NUM_BLOCKS (CONFIG_MP_NUM_CPUS * BURST * 4)
+#define ITERATIONS 100000
+#define STACK_SIZE 1024
+
+K_MEM_SLAB_DEFINE(bench_slab, BLK_SIZE, NUM_BLOCKS, 8);
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, CONFIG_MP_NUM_CPUS, STACK_SIZE);
+static struct k_thread threads[CONFIG_MP_NUM_CPUS];
+
+static void bench_fn(void *p1, void *p2, void *p3)
+{
+	void *blocks[BURST];
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int n = 0; n < ITERATIONS; n += BURST) {
+		for (int i = 0; i < BURST; i++) {
+			if (k_mem_slab_alloc(&bench_slab, &blocks[i],
+					     K_FOREVER) != 0) {
+				printk("alloc failed\n");
+				return;
+			}
+		}
+		for (int i = 0; i < BURST; i++) {
+			k_mem_slab_free(&bench_slab, &blocks[i]);
+		}
+	}
+}
+
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+static void print_hit_rate(struct k_mem_slab_magazine_stats *prev)
+{
+	struct k_mem_slab_magazine_stats now;
+	u32_t hits, total;
+
+	k_mem_slab_magazine_stats_get(&bench_slab, &now);
+	hits = (now.alloc_hits - prev->alloc_hits) +
+	       (now.free_hits - prev->free_hits);
+	total = hits + (now.alloc_misses - prev->alloc_misses) +
+		(now.free_misses - prev->free_misses);
+
+	printk("        magazine hit rate %3u%%\n",
+	       total == 0U ? 0U : (u32_t)((u64_t)hits * 100U / total));
+	*prev = now;
+}
+#endif
+
+void main(void)
+{
+	int prio = k_thread_priority_get(k_current_get()) + 1;
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+	struct k_mem_slab_magazine_stats stats;
+
+	k_mem_slab_magazine_stats_get(&bench_slab, &stats);
+#endif
+
+	printk("memory slab magazines: %s\n",
+	       IS_ENABLED(CONFIG_MEM_SLAB_MAGAZINE) ? "on" : "off");
+
+	for (int n = 1; n <= CONFIG_MP_NUM_CPUS; n++) {
+		u32_t t0 = k_cycle_get_32();
+		u64_t us;
+
+		for (int i = 0; i < n; i++) {
+			k_thread_create(&threads[i], stacks[i], STACK_SIZE,
+					bench_fn, NULL, NULL, NULL,
+					prio, 0, K_NO_WAIT);
+		}
+
+		for (int i = 0; i < n; i++) {
+			k_thread_join(&threads[i], K_FOREVER);
+		}
+
+		us = k_cyc_to_us_floor64(k_cycle_get_32() - t0);
+		printk("cpus %d alloc+free/ms %6u\n", n, us == 0U ? 0U :
+		       (u32_t)((u64_t)n * ITERATIONS * 1000U / us));
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+		print_hit_rate(&stats);
+#endif
+	}
+
+	printk("fin\n");
+}
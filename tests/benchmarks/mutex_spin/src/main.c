@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+
+/* Mutex contention benchmark, see README.rst */
+
+#define NUM_THREADS CONFIG_MP_NUM_CPUS
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define CRITICAL_LOOPS 200
+#define LOCAL_LOOPS 100
+#define RUN_SECONDS 5
+
+#ifdef CONFIG_MUTEX_ADAPTIVE_SPIN
+#define SPIN_US CONFIG_MUTEX_SPIN_US
+#else
+#define SPIN_US 0
+#endif
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, NUM_THREADS, STACK_SIZE);
+static struct k_thread threads[NUM_THREADS];
+
+K_MUTEX_DEFINE(contended);
+
+static volatile bool stop;
+static volatile u32_t work;
+static u32_t acquisitions[NUM_THREADS];
+static u32_t waits[NUM_THREADS];
+static u64_t wait_cycles[NUM_THREADS];
+
+static void busy(int loops)
+{
+	for (int i = 0; i < loops; i++) {
+		work++;
+	}
+}
+
+static void contender(void *p1, void *p2, void *p3)
+{
+	int id = POINTER_TO_INT(p1);
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (!stop) {
+		/* Only time the acquisitions that had to wait */
+		if (k_mutex_lock(&contended, K_NO_WAIT) != 0) {
+			u32_t start = k_cycle_get_32();
+
+			k_mutex_lock(&contended, K_FOREVER);
+			wait_cycles[id] += k_cycle_get_32() - start;
+			waits[id]++;
+		}
+		busy(CRITICAL_LOOPS);
+		acquisitions[id]++;
+		k_mutex_unlock(&contended);
+
+		busy(LOCAL_LOOPS);
+	}
+}
+
+void main(void)
+{
+	u32_t total_acq = 0U, total_waits = 0U;
+	u64_t total_cycles = 0U;
+
+	for (int i = 0; i < NUM_THREADS; i++) {
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE,
+				contender, INT_TO_POINTER(i), NULL, NULL,
+				K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	}
+
+	k_sleep(K_SECONDS(RUN_SECONDS));
+	stop = true;
+
+	for (int i = 0; i < NUM_THREADS; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+		total_acq += acquisitions[i];
+		total_waits += waits[i];
+		total_cycles += wait_cycles[i];
+	}
+
+	printk("threads %d spin %d us acquisitions/s %u waits/s %u "
+	       "avg wait %u ns\n", NUM_THREADS, SPIN_US,
+	       total_acq / RUN_SECONDS, total_waits / RUN_SECONDS,
+	       total_waits ? (u32_t)k_cyc_to_ns_floor64(total_cycles /
+						       total_waits) : 0U);
+	printk("fin\n");
+}
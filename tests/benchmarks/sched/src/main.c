@@ -95,6 +95,101 @@ static void partner_fn(void *arg1, void *arg2, void *arg3)
 	}
 }
 
+#ifdef CONFIG_SMP
+
+/* SMP scaling: N pairs of threads are run for SMP_RUN_MS each, first
+ * one pair, then two, and so on up to one pair per CPU, reporting the
+ * aggregate rate.  In the "switch" phase both threads of a pair sit at
+ * the same priority and k_yield() to each other, exercising the run
+ * queue and the context switch.  In the "wakeup" phase they ping-pong
+ * through a pair of semaphores, so every handoff is a pend, a wakeup
+ * and a switch.  All CPUs share one run queue and scheduler lock, so
+ * the aggregate rate flattens as CPUs are added.
+ */
+#define SMP_RUN_MS 1000
+#define SMP_STACK_SIZE 1024
+#define SMP_THREADS (2 * CONFIG_MP_NUM_CPUS)
+
+static K_THREAD_STACK_ARRAY_DEFINE(smp_stacks, SMP_THREADS, SMP_STACK_SIZE);
+static struct k_thread smp_threads[SMP_THREADS];
+static struct k_sem smp_sems[SMP_THREADS];
+static u32_t smp_ops[SMP_THREADS];
+static volatile bool smp_stop;
+
+static void smp_yield_fn(void *p1, void *p2, void *p3)
+{
+	int id = POINTER_TO_INT(p1);
+	u32_t ops = 0U;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (!smp_stop) {
+		k_yield();
+		ops++;
+	}
+
+	smp_ops[id] = ops;
+}
+
+static void smp_wake_fn(void *p1, void *p2, void *p3)
+{
+	int id = POINTER_TO_INT(p1);
+	struct k_sem *mine = &smp_sems[id];
+	struct k_sem *peer = &smp_sems[id ^ 1];
+	u32_t ops = 0U;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (!smp_stop) {
+		if (k_sem_take(mine, K_MSEC(10)) == 0) {
+			ops++;
+		}
+		k_sem_give(peer);
+	}
+
+	/* Don't leave the peer waiting on us */
+	k_sem_give(peer);
+	smp_ops[id] = ops;
+}
+
+static u32_t smp_run(int pairs, k_thread_entry_t fn)
+{
+	int prio = k_thread_priority_get(k_current_get()) + 1;
+	u32_t total = 0U;
+
+	smp_stop = false;
+	for (int i = 0; i < 2 * pairs; i++) {
+		k_sem_init(&smp_sems[i], (i & 1) ? 0 : 1, 1);
+		k_thread_create(&smp_threads[i], smp_stacks[i],
+				SMP_STACK_SIZE, fn, INT_TO_POINTER(i),
+				NULL, NULL, prio, 0, K_NO_WAIT);
+	}
+
+	k_msleep(SMP_RUN_MS);
+	smp_stop = true;
+
+	for (int i = 0; i < 2 * pairs; i++) {
+		k_thread_join(&smp_threads[i], K_FOREVER);
+		total += smp_ops[i];
+	}
+
+	return total / SMP_RUN_MS;
+}
+
+static void bench_smp(void)
+{
+	for (int n = 1; n <= CONFIG_MP_NUM_CPUS; n++) {
+		u32_t sw = smp_run(n, smp_yield_fn);
+		u32_t wake = smp_run(n, smp_wake_fn);
+
+		printk("cpus %d switch/ms %6u wakeup/ms %6u\n", n, sw, wake);
+	}
+}
+
+#endif /* CONFIG_SMP */
+
 void main(void)
 {
 	z_waitq_init(&waitq);
@@ -157,5 +252,9 @@ void main(void)
 		       stamps[4] - stamps[3],
 		       whole, avg);
 	}
+
+#ifdef CONFIG_SMP
+	bench_smp();
+#endif
 	printk("fin\n");
 }
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <timeout_q.h>
+
+/* Timeout queue microbenchmark, see README.rst.  It talks to the
+ * timeout queue directly with z_add_timeout()/z_abort_timeout() so
+ * that the numbers reflect the queue backend and not the overhead of
+ * k_timer or k_delayed_work on top of it.
+ */
+
+#define MAX_TIMEOUTS 1024
+#define N_EXPIRE 16
+
+/* Far timeouts are spread over this many ticks past FAR_BASE, well
+ * beyond anything the benchmark will ever sleep for
+ */
+#define FAR_BASE 100000
+#define FAR_SPREAD 65536
+
+static const int depths[] = { 1, 4, 16, 64, 256, 1024 };
+
+static struct _timeout far_timeouts[MAX_TIMEOUTS];
+static struct _timeout near_timeouts[N_EXPIRE];
+
+static volatile int n_expired;
+static u32_t first_expiry, last_expiry;
+
+static u32_t seed = 0x5eed;
+
+static u32_t next_rand(void)
+{
+	/* Numerical Recipes LCG, plenty for spreading deadlines */
+	seed = seed * 1664525U + 1013904223U;
+	return seed >> 8;
+}
+
+static void far_fn(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+}
+
+static void near_fn(struct _timeout *t)
+{
+	u32_t now = k_cycle_get_32();
+
+	ARG_UNUSED(t);
+
+	if (n_expired++ == 0) {
+		first_expiry = now;
+	}
+	last_expiry = now;
+}
+
+static void arm_far(int n)
+{
+	for (int i = 0; i < n; i++) {
+		k_ticks_t dt = FAR_BASE + (next_rand() % FAR_SPREAD);
+
+		z_init_timeout(&far_timeouts[i]);
+		z_add_timeout(&far_timeouts[i], far_fn, K_TICKS(dt));
+	}
+}
+
+static void abort_far(int n)
+{
+	for (int i = 0; i < n; i++) {
+		z_abort_timeout(&far_timeouts[i]);
+	}
+}
+
+static u32_t bench_insert(int n)
+{
+	unsigned int key = irq_lock();
+	u32_t t0 = k_cycle_get_32();
+
+	arm_far(n);
+
+	u32_t t1 = k_cycle_get_32();
+
+	irq_unlock(key);
+	return (t1 - t0) / n;
+}
+
+static u32_t bench_abort(int n)
+{
+	unsigned int key = irq_lock();
+	u32_t t0 = k_cycle_get_32();
+
+	abort_far(n);
+
+	u32_t t1 = k_cycle_get_32();
+
+	irq_unlock(key);
+	return (t1 - t0) / n;
+}
+
+static u32_t bench_expire(int n)
+{
+	arm_far(n);
+
+	/* Align to a tick boundary so the whole batch lands in one
+	 * z_clock_announce() call
+	 */
+	k_sleep(K_TICKS(1));
+
+	n_expired = 0;
+	for (int i = 0; i < N_EXPIRE; i++) {
+		z_init_timeout(&near_timeouts[i]);
+		z_add_timeout(&near_timeouts[i], near_fn, K_TICKS(2));
+	}
+
+	while (n_expired < N_EXPIRE) {
+		k_sleep(K_TICKS(1));
+	}
+
+	abort_far(n);
+
+	return (last_expiry - first_expiry) / (N_EXPIRE - 1);
+}
+
+#ifdef CONFIG_SMP
+
+/* SMP scaling: one thread per CPU arms and cancels its own k_timer as
+ * fast as it can for SMP_RUN_MS, first on one CPU, then two, and so
+ * on.  With a shared timeout queue the aggregate rate flattens out as
+ * CPUs fight over the queue lock; with CONFIG_TIMEOUT_QUEUE_PER_CPU it
+ * should grow with the number of CPUs.
+ */
+#define SMP_RUN_MS 1000
+#define SMP_STACK_SIZE 1024
+
+static K_THREAD_STACK_ARRAY_DEFINE(smp_stacks, CONFIG_MP_NUM_CPUS,
+				   SMP_STACK_SIZE);
+static struct k_thread smp_threads[CONFIG_MP_NUM_CPUS];
+static struct k_timer smp_timers[CONFIG_MP_NUM_CPUS];
+static u32_t smp_ops[CONFIG_MP_NUM_CPUS];
+static volatile bool smp_stop;
+
+static void smp_fn(void *p1, void *p2, void *p3)
+{
+	int id = POINTER_TO_INT(p1);
+	u32_t ops = 0U;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (!smp_stop) {
+		k_timer_start(&smp_timers[id], K_TICKS(FAR_BASE), K_NO_WAIT);
+		k_timer_stop(&smp_timers[id]);
+		ops++;
+	}
+
+	smp_ops[id] = ops;
+}
+
+static void bench_smp(void)
+{
+	int prio = k_thread_priority_get(k_current_get()) + 1;
+
+	for (int n = 1; n <= CONFIG_MP_NUM_CPUS; n++) {
+		u32_t total = 0U;
+
+		smp_stop = false;
+		for (int i = 0; i < n; i++) {
+			k_timer_init(&smp_timers[i], NULL, NULL);
+			k_thread_create(&smp_threads[i], smp_stacks[i],
+					SMP_STACK_SIZE, smp_fn,
+					INT_TO_POINTER(i), NULL, NULL,
+					prio, 0, K_NO_WAIT);
+		}
+
+		k_msleep(SMP_RUN_MS);
+		smp_stop = true;
+
+		for (int i = 0; i < n; i++) {
+			k_thread_join(&smp_threads[i], K_FOREVER);
+			total += smp_ops[i];
+		}
+
+		printk("cpus %d arm+cancel/ms %6u\n", n, total / SMP_RUN_MS);
+	}
+}
+
+#endif /* CONFIG_SMP */
+
+void main(void)
+{
+	printk("timeout queue backend: %s\n",
+	       IS_ENABLED(CONFIG_TIMEOUT_QUEUE_SCALABLE) ? "scalable"
+							 : "dumb");
+
+	for (int i = 0; i < ARRAY_SIZE(depths); i++) {
+		int n = depths[i];
+		u32_t insert = bench_insert(n);
+		u32_t abort = bench_abort(n);
+		u32_t expire = bench_expire(n);
+
+		printk("timeouts %5d insert %6u abort %6u expire %6u\n",
+		       n, insert, abort, expire);
+	}
+
+#ifdef CONFIG_SMP
+	bench_smp();
+#endif
+	printk("fin\n");
+}
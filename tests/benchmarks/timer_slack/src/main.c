@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+
+/* Timer slack wakeup benchmark, see README.rst */
+
+#define NUM_TIMERS 16
+#define BASE_PERIOD_MS 100
+#define PERIOD_STEP_MS 13
+#define SLACK_MS 10
+#define RUN_SECONDS 10
+
+static struct k_timer timers[NUM_TIMERS];
+
+static struct k_spinlock lock;
+static u32_t last_stamp;
+static u32_t expirations;
+static u32_t wakeups;
+
+static void expiry_fn(struct k_timer *timer)
+{
+	u32_t half_tick = sys_clock_hw_cycles_per_sec() /
+			  CONFIG_SYS_CLOCK_TICKS_PER_SEC / 2;
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	u32_t now = k_cycle_get_32();
+
+	ARG_UNUSED(timer);
+
+	if (expirations == 0 || now - last_stamp > half_tick) {
+		wakeups++;
+	}
+	last_stamp = now;
+	expirations++;
+
+	k_spin_unlock(&lock, key);
+}
+
+void main(void)
+{
+	k_spinlock_key_t key;
+
+	for (int i = 0; i < NUM_TIMERS; i++) {
+		k_timer_init(&timers[i], expiry_fn, NULL);
+		k_timer_slack_set(&timers[i], K_MSEC(SLACK_MS));
+	}
+
+	for (int i = 0; i < NUM_TIMERS; i++) {
+		k_timeout_t period = K_MSEC(BASE_PERIOD_MS +
+					    i * PERIOD_STEP_MS);
+
+		k_timer_start(&timers[i], period, period);
+	}
+
+	k_sleep(K_SECONDS(RUN_SECONDS));
+
+	for (int i = 0; i < NUM_TIMERS; i++) {
+		k_timer_stop(&timers[i]);
+	}
+
+	key = k_spin_lock(&lock);
+	printk("timers %d slack %d ms expirations/s %u wakeups/s %u\n",
+	       NUM_TIMERS, IS_ENABLED(CONFIG_TIMEOUT_SLACK) ? SLACK_MS : 0,
+	       expirations / RUN_SECONDS, wakeups / RUN_SECONDS);
+	k_spin_unlock(&lock, key);
+
+	printk("fin\n");
+}
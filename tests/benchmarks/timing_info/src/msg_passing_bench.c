@@ -366,7 +366,7 @@ void thread_producer_get_msgq_w_cxt_switch(void *p1, void *p2, void *p3)
 
 void thread_consumer_get_msgq_w_cxt_switch(void *p1, void *p2, void *p3)
 {
-	producer_get_w_cxt_switch_tid->base.timeout.dticks = _EXPIRED;
+	z_abort_timeout(&producer_get_w_cxt_switch_tid->base.timeout);
 	arch_timing_value_swap_end = 1U;
 	TIMING_INFO_PRE_READ();
 	__msg_q_get_w_cxt_start_time = TIMING_INFO_OS_GET_TIME();
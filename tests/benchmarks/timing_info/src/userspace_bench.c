@@ -206,7 +206,11 @@ void syscall_overhead(void)
 }
 
 /******************************************************************************/
+/* Number of dynamic objects allocated before the one being validated */
+#define DYN_OBJ_COUNT 16
+
 K_SEM_DEFINE(test_sema, 1, 10);
+struct k_sem *validation_sema;
 u32_t validation_overhead_obj_init_start_time;
 u32_t validation_overhead_obj_init_end_time;
 u32_t validation_overhead_obj_start_time;
@@ -222,7 +226,7 @@ static inline int z_vrfy_validation_overhead_syscall(void)
 	TIMING_INFO_PRE_READ();
 	validation_overhead_obj_init_start_time = TIMING_INFO_GET_TIMER_VALUE();
 
-	bool status_0 = Z_SYSCALL_OBJ_INIT(&test_sema, K_OBJ_SEM);
+	bool status_0 = Z_SYSCALL_OBJ_INIT(validation_sema, K_OBJ_SEM);
 
 	TIMING_INFO_PRE_READ();
 	validation_overhead_obj_init_end_time = TIMING_INFO_GET_TIMER_VALUE();
@@ -231,7 +235,7 @@ static inline int z_vrfy_validation_overhead_syscall(void)
 	TIMING_INFO_PRE_READ();
 	validation_overhead_obj_start_time = TIMING_INFO_GET_TIMER_VALUE();
 
-	bool status_1 = Z_SYSCALL_OBJ(&test_sema, K_OBJ_SEM);
+	bool status_1 = Z_SYSCALL_OBJ(validation_sema, K_OBJ_SEM);
 
 	TIMING_INFO_PRE_READ();
 	validation_overhead_obj_end_time = TIMING_INFO_GET_TIMER_VALUE();
@@ -245,9 +249,12 @@ void validation_overhead_user_thread(void *p1, void *p2, void *p3)
 	validation_overhead_syscall();
 }
 
-void validation_overhead(void)
+static void validation_overhead_measure(struct k_sem *sem,
+					const char *init_label,
+					const char *perm_label)
 {
-	k_thread_access_grant(k_current_get(), &test_sema);
+	validation_sema = sem;
+	k_thread_access_grant(k_current_get(), sem);
 
 
 	k_thread_create(&my_thread_user, my_stack_area, STACK_SIZE,
@@ -272,15 +279,42 @@ void validation_overhead(void)
 	u32_t  total_validation_overhead_obj_time =
 		CYCLES_TO_NS(total_cycles_obj);
 
-	PRINT_STATS("Validation overhead k object init",
+	PRINT_STATS(init_label,
 		    total_cycles_obj_init,
 		    (u32_t) (total_validation_overhead_obj_init_time  &
 			     0xFFFFFFFFULL));
 
-	PRINT_STATS("Validation overhead k object permission",
+	PRINT_STATS(perm_label,
 		    total_cycles_obj,
 		    (u32_t) (total_validation_overhead_obj_time  &
 			     0xFFFFFFFFULL));
+}
+
+void validation_overhead(void)
+{
+	validation_overhead_measure(&test_sema,
+				    "Validation overhead k object init",
+				    "Validation overhead k object permission");
 
+#ifdef CONFIG_DYNAMIC_OBJECTS
+	struct k_sem *sem = NULL;
 
+	/* Objects allocated at runtime are not in the build time table,
+	 * and are looked up among all those allocated so far
+	 */
+	k_thread_system_pool_assign(k_current_get());
+
+	for (int i = 0; i < DYN_OBJ_COUNT; i++) {
+		sem = k_object_alloc(K_OBJ_SEM);
+		if (sem == NULL) {
+			TC_PRINT("Failed to allocate dynamic kernel objects\n");
+			return;
+		}
+	}
+
+	k_sem_init(sem, 1, 10);
+	validation_overhead_measure(sem,
+			"Validation overhead dynamic k object init",
+			"Validation overhead dynamic k object permission");
+#endif
 }
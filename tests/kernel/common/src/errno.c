@@ -39,17 +39,44 @@ struct result result[N_THREADS];
 
 struct k_fifo fifo;
 
+#ifdef CONFIG_THREAD_LOCAL_STORAGE
+#define TLS_INIT_VALUE 0x600dcafe
+
+static __thread int tls_value = TLS_INIT_VALUE;
+static __thread u8_t tls_zeroed[8];
+
+static bool tls_is_initial(void)
+{
+	for (int i = 0; i < sizeof(tls_zeroed); i++) {
+		if (tls_zeroed[i] != 0U) {
+			return false;
+		}
+	}
+
+	return tls_value == TLS_INIT_VALUE;
+}
+#endif
+
 static void errno_thread(void *_n, void *_my_errno, void *_unused)
 {
 	int n = POINTER_TO_INT(_n);
 	int my_errno = POINTER_TO_INT(_my_errno);
 
 	errno = my_errno;
+#ifdef CONFIG_THREAD_LOCAL_STORAGE
+	zassert_true(tls_is_initial(), NULL);
+	tls_value = my_errno;
+	tls_zeroed[n] = n + 1;
+#endif
 
 	k_msleep(30 - (n * 10));
 	if (errno == my_errno) {
 		result[n].pass = 1;
 	}
+#ifdef CONFIG_THREAD_LOCAL_STORAGE
+	zassert_equal(tls_value, my_errno, NULL);
+	zassert_equal(tls_zeroed[n], n + 1, NULL);
+#endif
 
 	zassert_equal(errno, my_errno, NULL);
 
@@ -26,6 +26,7 @@ extern void test_sys_get_le64(void);
 extern void test_sys_put_le64(void);
 extern void test_atomic(void);
 extern void test_printk(void);
+extern void test_printk_deferred(void);
 extern void test_timeout_order(void);
 extern void test_clock_cycle(void);
 extern void test_clock_uptime(void);
@@ -58,6 +59,13 @@ void test_printk(void)
 }
 #endif
 
+#ifndef CONFIG_PRINTK_DEFERRED
+void test_printk_deferred(void)
+{
+	ztest_test_skip();
+}
+#endif
+
 /**
  * @brief Test sys_kernel_version_get() functionality
  *
@@ -118,6 +126,7 @@ void test_main(void)
 			 ztest_user_unit_test(test_atomic),
 			 ztest_unit_test(test_bitfield),
 			 ztest_unit_test(test_printk),
+			 ztest_unit_test(test_printk_deferred),
 			 ztest_unit_test(test_timeout_order),
 			 ztest_1cpu_user_unit_test(test_clock_uptime),
 			 ztest_unit_test(test_clock_cycle),
@@ -137,7 +137,78 @@ void test_printk(void)
 			  0xFFFFFFFFFULL, -1LL, -1ULL, -1ULL);
 	pk_console[count] = '\0';
 	zassert_true((strcmp(pk_console, expected) == 0), "snprintk failed");
+
+	__printk_hook_install(_old_char_out);
+}
+
+#ifdef CONFIG_PRINTK_DEFERRED
+static void flush_deferred(void)
+{
+	while (printk_deferred_process()) {
+	}
+	pk_console[pos] = '\0';
 }
+
+/**
+ * @brief Test printk_deferred() functionality
+ *
+ * Checks that deferred messages are formatted like printk() ones once
+ * processed, that string arguments are kept as pointers, and that
+ * messages that do not fit in the buffer are dropped and reported.
+ *
+ * @see printk_deferred(), printk_deferred_process()
+ */
+void test_printk_deferred(void)
+{
+	int i;
+
+	_old_char_out = __printk_get_hook();
+	__printk_hook_install(ram_console_out);
+
+	/* Flush what other tests may have left */
+	flush_deferred();
+	pos = 0;
+
+	printk_deferred("%zu %hhu %hu %u %lu %llu\n",
+			stv, uc, usi, ui, ul, ull);
+	printk_deferred("%c %hhd %hd %d %ld %lld\n", c, c, ssi, si, sl, sll);
+	printk_deferred("0x%x %p\n", hex, ptr);
+	printk_deferred("0x%x 0x%02x 0x%04x 0x%08x 0x%016x\n", 1, 1, 1, 1, 1);
+	printk_deferred("0x%x 0x%2x 0x%4x 0x%8x\n", 1, 1, 1, 1);
+	printk_deferred("%d %02d %04d %08d\n", 42, 42, 42, 42);
+	printk_deferred("%d %02d %04d %08d\n", -42, -42, -42, -42);
+	printk_deferred("%u %2u %4u %8u\n", 42, 42, 42, 42);
+	printk_deferred("%u %02u %04u %08u\n", 42, 42, 42, 42);
+	printk_deferred("%-8u%-6d%-4x%-2p%8d\n",
+			0xFF, 42, 0xABCDEF, (char *)42, 42);
+	printk_deferred("%lld %lld %llu %llx\n",
+			0xFFFFFFFFFULL, -1LL, -1ULL, -1ULL);
+
+	flush_deferred();
+	zassert_true((strcmp(pk_console, expected) == 0),
+		     "printk_deferred failed");
+
+	pos = 0;
+	printk_deferred("no arguments\n");
+	printk_deferred("%s|%-6s|%c\n", "abc", "de", 'x');
+	flush_deferred();
+	zassert_true(strcmp(pk_console, "no arguments\nabc|de    |x\n") == 0,
+		     "printk_deferred strings failed");
+
+	/* TESTPOINT: messages that do not fit are dropped and counted */
+	pos = 0;
+	for (i = 0; i < CONFIG_PRINTK_DEFERRED_BUFFER_SIZE; i++) {
+		printk_deferred("%d\n", i);
+	}
+	flush_deferred();
+	zassert_true(strncmp(pk_console, "--- ", 4) == 0,
+		     "dropped messages not reported");
+	zassert_not_null(strstr(pk_console, " messages dropped ---\n0\n1\n"),
+			 "messages not output in order");
+
+	__printk_hook_install(_old_char_out);
+}
+#endif
 /**
  * @}
  */
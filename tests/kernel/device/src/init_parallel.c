@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <device.h>
+#include <init.h>
+#include <ztest.h>
+
+/* Devices declaring their init dependencies with INIT_PARALLEL():
+ *
+ *   PAR_SLOW <- PAR_MID <- PAR_LAST -> PAR_FAST
+ *   PAR_FAIL <- PAR_AFTER_FAIL
+ *
+ * Each init function records when it started and completed, on one
+ * sequence shared by all of them.
+ */
+struct par_record {
+	int delay_ms;
+	int ret;
+	atomic_val_t start;
+	atomic_val_t done;
+};
+
+static atomic_t par_seq;
+
+static struct par_record par_slow = { .delay_ms = 20 };
+static struct par_record par_fast;
+static struct par_record par_fail = { .delay_ms = 10, .ret = -EIO };
+static struct par_record par_mid = { .delay_ms = 5 };
+static struct par_record par_last;
+static struct par_record par_after_fail;
+
+static const int par_api;
+
+static int par_init(struct device *dev)
+{
+	struct par_record *r = dev->driver_data;
+
+	r->start = atomic_inc(&par_seq) + 1;
+	if (r->delay_ms != 0) {
+		k_msleep(r->delay_ms);
+	}
+	r->done = atomic_inc(&par_seq) + 1;
+
+	return r->ret;
+}
+
+DEVICE_AND_API_INIT(par_slow, "PAR_SLOW", par_init, &par_slow, NULL,
+		    POST_KERNEL, 60, &par_api);
+DEVICE_AND_API_INIT(par_fast, "PAR_FAST", par_init, &par_fast, NULL,
+		    POST_KERNEL, 60, &par_api);
+DEVICE_AND_API_INIT(par_fail, "PAR_FAIL", par_init, &par_fail, NULL,
+		    POST_KERNEL, 60, &par_api);
+DEVICE_AND_API_INIT(par_mid, "PAR_MID", par_init, &par_mid, NULL,
+		    POST_KERNEL, 61, &par_api);
+DEVICE_AND_API_INIT(par_after_fail, "PAR_AFTER_FAIL", par_init,
+		    &par_after_fail, NULL, POST_KERNEL, 61, &par_api);
+DEVICE_AND_API_INIT(par_last, "PAR_LAST", par_init, &par_last, NULL,
+		    POST_KERNEL, 62, &par_api);
+
+INIT_PARALLEL("PAR_SLOW");
+INIT_PARALLEL("PAR_FAST");
+INIT_PARALLEL("PAR_FAIL");
+INIT_PARALLEL("PAR_MID", "PAR_SLOW");
+INIT_PARALLEL("PAR_AFTER_FAIL", "PAR_FAIL");
+INIT_PARALLEL("PAR_LAST", "PAR_MID", "PAR_FAST");
+
+static void assert_after(struct par_record *dep, struct par_record *r)
+{
+	zassert_not_equal(dep->done, 0, "dependency did not complete");
+	zassert_not_equal(r->start, 0, "device was not initialized");
+	zassert_true(r->start > dep->done,
+		     "device started before its dependency completed");
+}
+
+/**
+ * @brief Test that devices are initialized after their dependencies
+ *
+ * With CONFIG_INIT_PARALLEL, also checks that independent devices were
+ * initialized concurrently.
+ *
+ * @see INIT_PARALLEL()
+ */
+void test_init_parallel_order(void)
+{
+	assert_after(&par_slow, &par_mid);
+	assert_after(&par_mid, &par_last);
+	assert_after(&par_fast, &par_last);
+
+	if (IS_ENABLED(CONFIG_INIT_PARALLEL)) {
+		zassert_true((par_slow.start < par_fail.done) &&
+			     (par_fail.start < par_slow.done),
+			     "independent devices were not run in parallel");
+	}
+}
+
+/**
+ * @brief Test a failing device init among parallel ones
+ *
+ * Devices depending on a device whose init failed are still
+ * initialized, while the failed device cannot be bound.
+ *
+ * @see INIT_PARALLEL()
+ */
+void test_init_parallel_failure(void)
+{
+	assert_after(&par_fail, &par_after_fail);
+
+	zassert_is_null(DEVICE_GET(par_fail)->driver_api,
+			"failed device kept its API");
+	zassert_is_null(device_get_binding("PAR_FAIL"), NULL);
+	zassert_not_null(device_get_binding("PAR_AFTER_FAIL"), NULL);
+}
@@ -15,6 +15,9 @@
 #define DUMMY_PORT_2    "dummy_driver"
 #define BAD_DRIVER	"bad_driver"
 
+extern void test_init_parallel_order(void);
+extern void test_init_parallel_failure(void);
+
 /**
  * @brief Test cases to verify device objects
  *
@@ -91,6 +94,32 @@ static void test_bogus_dynamic_name(void)
 	zassert_true(mux == NULL, NULL);
 }
 
+/**
+ * @brief Test device binding of every device
+ *
+ * Validates that each initialized device is found by its name, whether
+ * the name passed is the one it was defined with or a copy of it.
+ *
+ * @see device_get_binding()
+ */
+static void test_all_device_bindings(void)
+{
+	extern struct device __device_start[];
+	extern struct device __device_end[];
+	char name[Z_DEVICE_MAX_NAME_LEN];
+
+	for (struct device *dev = __device_start; dev != __device_end; dev++) {
+		if (dev->driver_api == NULL) {
+			continue;
+		}
+
+		zassert_equal_ptr(device_get_binding(dev->name), dev, NULL);
+
+		snprintk(name, sizeof(name), "%s", dev->name);
+		zassert_equal_ptr(device_get_binding(name), dev, NULL);
+	}
+}
+
 static struct init_record {
 	bool pre_kernel;
 	bool is_in_isr;
@@ -252,7 +281,10 @@ void test_main(void)
 			 ztest_unit_test(test_dummy_device_pm),
 			 ztest_unit_test(test_build_suspend_device_list),
 			 ztest_unit_test(test_dummy_device),
+			 ztest_unit_test(test_all_device_bindings),
 			 ztest_unit_test(test_pre_kernel_detection),
+			 ztest_unit_test(test_init_parallel_order),
+			 ztest_unit_test(test_init_parallel_failure),
 			 ztest_user_unit_test(test_bogus_dynamic_name),
 			 ztest_user_unit_test(test_dynamic_name));
 	ztest_run_test_suite(device);
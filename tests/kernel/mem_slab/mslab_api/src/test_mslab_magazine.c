@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include "test_mslab.h"
+
+#define MAG_BLK_NUM 16
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
+
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+static char __aligned(BLK_ALIGN) mag_buf[BLK_SIZE * MAG_BLK_NUM];
+static struct k_mem_slab mag_slab;
+static K_THREAD_STACK_DEFINE(mag_stack, STACK_SIZE);
+static struct k_thread mag_thread;
+
+static void tmslab_free_later(void *p1, void *p2, void *p3)
+{
+	void *block = p1;
+
+	k_sleep(K_MSEC(50));
+	k_mem_slab_free(&mag_slab, &block);
+}
+#endif
+
+/**
+ * @brief Verify per-CPU magazines in front of a memory slab
+ *
+ * @details Check that blocks cached in the current CPU's magazine are
+ * not reported as used, that alloc and free are served from the
+ * magazine once it is filled, that every block can still be allocated,
+ * and that a thread waiting on an exhausted slab gets a freed block.
+ *
+ * @ingroup kernel_memory_slab_tests
+ */
+void test_mslab_magazine(void)
+{
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+	struct k_mem_slab_magazine_stats stats;
+	u32_t batch = MAX(CONFIG_MEM_SLAB_MAGAZINE_SIZE / 2, 1);
+	void *block[MAG_BLK_NUM];
+	void *extra;
+
+	zassert_equal(k_mem_slab_init(&mag_slab, mag_buf, BLK_SIZE,
+				      MAG_BLK_NUM), 0, NULL);
+
+	/* the first allocation misses and refills the magazine */
+	zassert_equal(k_mem_slab_alloc(&mag_slab, &block[0], K_NO_WAIT), 0,
+		      NULL);
+	k_mem_slab_magazine_stats_get(&mag_slab, &stats);
+	zassert_equal(stats.alloc_misses, 1, NULL);
+	zassert_equal(stats.alloc_hits, 0, NULL);
+	zassert_equal(stats.cached, batch, NULL);
+	zassert_equal(k_mem_slab_num_used_get(&mag_slab), 1, NULL);
+	zassert_equal(k_mem_slab_num_free_get(&mag_slab), MAG_BLK_NUM - 1,
+		      NULL);
+
+	/* the following ones are served from the magazine */
+	for (int i = 1; i <= batch; i++) {
+		zassert_equal(k_mem_slab_alloc(&mag_slab, &block[i],
+					       K_NO_WAIT), 0, NULL);
+	}
+	k_mem_slab_magazine_stats_get(&mag_slab, &stats);
+	zassert_equal(stats.alloc_hits, batch, NULL);
+	zassert_equal(stats.cached, 0, NULL);
+
+	for (int i = 0; i <= batch; i++) {
+		k_mem_slab_free(&mag_slab, &block[i]);
+	}
+	k_mem_slab_magazine_stats_get(&mag_slab, &stats);
+	zassert_equal(stats.free_hits, batch + 1, NULL);
+	zassert_equal(k_mem_slab_num_used_get(&mag_slab), 0, NULL);
+
+	/* cached blocks are not lost: the whole slab can be allocated */
+	for (int i = 0; i < MAG_BLK_NUM; i++) {
+		zassert_equal(k_mem_slab_alloc(&mag_slab, &block[i],
+					       K_NO_WAIT), 0, NULL);
+		zassert_not_null(block[i], NULL);
+		for (int j = 0; j < i; j++) {
+			zassert_not_equal(block[i], block[j], NULL);
+		}
+	}
+	zassert_equal(k_mem_slab_alloc(&mag_slab, &extra, K_NO_WAIT),
+		      -ENOMEM, NULL);
+	zassert_equal(k_mem_slab_num_free_get(&mag_slab), 0, NULL);
+
+	/* a block freed while a thread waits goes to that thread */
+	k_thread_create(&mag_thread, mag_stack, STACK_SIZE,
+			tmslab_free_later, block[0], NULL, NULL,
+			K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	zassert_equal(k_mem_slab_alloc(&mag_slab, &extra, K_MSEC(TIMEOUT)),
+		      0, NULL);
+	zassert_equal(extra, block[0], NULL);
+	k_thread_join(&mag_thread, K_FOREVER);
+
+	for (int i = 0; i < MAG_BLK_NUM; i++) {
+		k_mem_slab_free(&mag_slab, &block[i]);
+	}
+	zassert_equal(k_mem_slab_num_used_get(&mag_slab), 0, NULL);
+	zassert_equal(k_mem_slab_num_free_get(&mag_slab), MAG_BLK_NUM, NULL);
+#else
+	ztest_test_skip();
+#endif
+}
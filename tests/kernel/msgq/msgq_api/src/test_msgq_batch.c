@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "test_msgq.h"
+
+#define BATCH_LEN 5
+
+K_THREAD_STACK_EXTERN(tstack);
+extern struct k_thread tdata;
+extern struct k_msgq msgq;
+static ZTEST_BMEM char __aligned(4) tbuffer[MSG_SIZE * BATCH_LEN];
+static ZTEST_DMEM u32_t in[2 * BATCH_LEN];
+static ZTEST_BMEM u32_t out[2 * BATCH_LEN];
+static ZTEST_BMEM u32_t rx;
+static ZTEST_BMEM int put_ret;
+
+static void fill(void)
+{
+	for (int i = 0; i < ARRAY_SIZE(in); i++) {
+		in[i] = MSG0 + i;
+	}
+	(void)memset(out, 0, sizeof(out));
+}
+
+static void batch_put_get(struct k_msgq *q)
+{
+	int ret;
+
+	fill();
+
+	/* move the ring pointers so the next batch wraps around */
+	for (int i = 0; i < 3; i++) {
+		zassert_equal(k_msgq_put(q, &in[0], K_NO_WAIT), 0, NULL);
+		zassert_equal(k_msgq_get(q, &out[0], K_NO_WAIT), 0, NULL);
+	}
+
+	/**TESTPOINT: only as many messages as fit are sent */
+	ret = k_msgq_put_batch(q, in, 2 * BATCH_LEN, K_NO_WAIT);
+	zassert_equal(ret, BATCH_LEN, NULL);
+	zassert_equal(k_msgq_num_used_get(q), BATCH_LEN, NULL);
+
+	ret = k_msgq_put_batch(q, in, 1, K_NO_WAIT);
+	zassert_equal(ret, -ENOMSG, NULL);
+
+	/**TESTPOINT: messages are received in order across the wrap */
+	ret = k_msgq_get_batch(q, out, 2, K_NO_WAIT);
+	zassert_equal(ret, 2, NULL);
+	ret = k_msgq_get_batch(q, &out[2], 2 * BATCH_LEN, K_NO_WAIT);
+	zassert_equal(ret, BATCH_LEN - 2, NULL);
+	zassert_equal(memcmp(in, out, BATCH_LEN * MSG_SIZE), 0, NULL);
+
+	ret = k_msgq_get_batch(q, out, 1, K_NO_WAIT);
+	zassert_equal(ret, -ENOMSG, NULL);
+	ret = k_msgq_get_batch(q, out, 1, TIMEOUT);
+	zassert_equal(ret, -EAGAIN, NULL);
+}
+
+static void reader_entry(void *p1, void *p2, void *p3)
+{
+	zassert_equal(k_msgq_get((struct k_msgq *)p1, &rx, K_FOREVER), 0,
+		      NULL);
+}
+
+static void start_reader(struct k_msgq *q, u32_t options)
+{
+	rx = 0U;
+	k_thread_create(&tdata, tstack, STACK_SIZE, reader_entry, q,
+			NULL, NULL, K_PRIO_PREEMPT(0), options, K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 1);
+}
+
+static void writer_entry(void *p1, void *p2, void *p3)
+{
+	put_ret = k_msgq_put((struct k_msgq *)p1, &in[1], K_FOREVER);
+}
+
+static void batch_put_to_reader(struct k_msgq *q, u32_t options)
+{
+	int ret;
+
+	fill();
+	start_reader(q, options);
+
+	/**TESTPOINT: a waiting reader gets the first message of a batch */
+	ret = k_msgq_put_batch(q, in, 3, K_NO_WAIT);
+	zassert_equal(ret, 3, NULL);
+	k_thread_join(&tdata, K_FOREVER);
+	zassert_equal(rx, in[0], NULL);
+
+	ret = k_msgq_get_batch(q, out, BATCH_LEN, K_NO_WAIT);
+	zassert_equal(ret, 2, NULL);
+	zassert_equal(memcmp(&in[1], out, 2 * MSG_SIZE), 0, NULL);
+}
+
+/**
+ * @addtogroup kernel_message_queue_tests
+ * @{
+ */
+
+/**
+ * @brief Test batch send and receive
+ * @see k_msgq_put_batch(), k_msgq_get_batch()
+ */
+void test_msgq_batch(void)
+{
+	k_msgq_init(&msgq, tbuffer, MSG_SIZE, BATCH_LEN);
+
+	batch_put_get(&msgq);
+	batch_put_to_reader(&msgq, 0);
+}
+
+/**
+ * @brief Test building messages in place with claim and commit
+ * @see k_msgq_put_claim(), k_msgq_put_commit()
+ */
+void test_msgq_claim_commit(void)
+{
+	u32_t *slot;
+	int ret;
+
+	fill();
+	k_msgq_init(&msgq, tbuffer, MSG_SIZE, BATCH_LEN);
+
+	/* leave the write pointer two slots before the end */
+	for (int i = 0; i < 3; i++) {
+		zassert_equal(k_msgq_put(&msgq, &in[0], K_NO_WAIT), 0, NULL);
+		zassert_equal(k_msgq_get(&msgq, &out[0], K_NO_WAIT), 0, NULL);
+	}
+
+	zassert_equal(k_msgq_put_claim(&msgq, (void **)&slot, 0), -EINVAL,
+		      NULL);
+
+	/**TESTPOINT: a claim stops at the end of the ring buffer */
+	ret = k_msgq_put_claim(&msgq, (void **)&slot, BATCH_LEN);
+	zassert_equal(ret, 2, NULL);
+	zassert_equal(k_msgq_num_free_get(&msgq), BATCH_LEN - 2, NULL);
+
+	/**TESTPOINT: other producers are refused while a claim is open */
+	zassert_equal(k_msgq_put(&msgq, &in[0], K_NO_WAIT), -EBUSY, NULL);
+	zassert_equal(k_msgq_put_batch(&msgq, in, 1, K_NO_WAIT), -EBUSY,
+		      NULL);
+	zassert_equal(k_msgq_put_claim(&msgq, (void **)&slot, 1), -EBUSY,
+		      NULL);
+	zassert_equal(k_msgq_num_used_get(&msgq), 0, NULL);
+
+	/**TESTPOINT: committing part of a claim releases the rest */
+	slot[0] = in[0];
+	zassert_equal(k_msgq_put_commit(&msgq, 3), -EINVAL, NULL);
+	zassert_equal(k_msgq_put_commit(&msgq, 1), 0, NULL);
+	zassert_equal(k_msgq_num_used_get(&msgq), 1, NULL);
+	zassert_equal(k_msgq_num_free_get(&msgq), BATCH_LEN - 1, NULL);
+
+	ret = k_msgq_put_claim(&msgq, (void **)&slot, BATCH_LEN);
+	zassert_equal(ret, 1, NULL);
+	slot[0] = in[1];
+	zassert_equal(k_msgq_put_commit(&msgq, 1), 0, NULL);
+
+	/* wrapped: the next claim starts at the beginning of the buffer */
+	ret = k_msgq_put_claim(&msgq, (void **)&slot, BATCH_LEN);
+	zassert_equal(ret, BATCH_LEN - 2, NULL);
+	zassert_equal((char *)slot, tbuffer, NULL);
+	slot[0] = in[2];
+	zassert_equal(k_msgq_put_commit(&msgq, 1), 0, NULL);
+
+	ret = k_msgq_get_batch(&msgq, out, BATCH_LEN, K_NO_WAIT);
+	zassert_equal(ret, 3, NULL);
+	zassert_equal(memcmp(in, out, 3 * MSG_SIZE), 0, NULL);
+
+	/**TESTPOINT: committed messages go straight to a waiting reader */
+	start_reader(&msgq, 0);
+	ret = k_msgq_put_claim(&msgq, (void **)&slot, 2);
+	zassert_equal(ret, 2, NULL);
+	slot[0] = in[3];
+	slot[1] = in[4];
+	zassert_equal(k_msgq_put_commit(&msgq, 2), 0, NULL);
+	k_thread_join(&tdata, K_FOREVER);
+	zassert_equal(rx, in[3], NULL);
+	zassert_equal(k_msgq_get(&msgq, &out[0], K_NO_WAIT), 0, NULL);
+	zassert_equal(out[0], in[4], NULL);
+	zassert_equal(k_msgq_num_used_get(&msgq), 0, NULL);
+}
+
+/**
+ * @brief Test that senders wait for an open claim to be committed
+ * @see k_msgq_put_claim(), k_msgq_put_commit(), k_msgq_put()
+ */
+void test_msgq_claim_wait(void)
+{
+	u32_t *slot;
+	int ret;
+
+	fill();
+	k_msgq_init(&msgq, tbuffer, MSG_SIZE, BATCH_LEN);
+
+	ret = k_msgq_put_claim(&msgq, (void **)&slot, 1);
+	zassert_equal(ret, 1, NULL);
+
+	/**TESTPOINT: senders time out while the claim stays open */
+	zassert_equal(k_msgq_put(&msgq, &in[1], TIMEOUT), -EAGAIN, NULL);
+	zassert_equal(k_msgq_put_batch(&msgq, in, 1, TIMEOUT), -EAGAIN,
+		      NULL);
+
+	/**TESTPOINT: a waiting sender is let through by the commit,
+	 * behind the committed message
+	 */
+	put_ret = -EINVAL;
+	k_thread_create(&tdata, tstack, STACK_SIZE, writer_entry, &msgq,
+			NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 1);
+	zassert_equal(put_ret, -EINVAL, "sender overtook the claim");
+	zassert_equal(k_msgq_num_used_get(&msgq), 0, NULL);
+
+	slot[0] = in[0];
+	zassert_equal(k_msgq_put_commit(&msgq, 1), 0, NULL);
+	k_thread_join(&tdata, K_FOREVER);
+	zassert_equal(put_ret, 0, NULL);
+
+	ret = k_msgq_get_batch(&msgq, out, BATCH_LEN, K_NO_WAIT);
+	zassert_equal(ret, 2, NULL);
+	zassert_equal(memcmp(in, out, 2 * MSG_SIZE), 0, NULL);
+}
+
+#ifdef CONFIG_USERSPACE
+/**
+ * @brief Test batch send and receive from user mode
+ * @see k_msgq_put_batch(), k_msgq_get_batch()
+ */
+void test_msgq_user_batch(void)
+{
+	struct k_msgq *q;
+
+	q = k_object_alloc(K_OBJ_MSGQ);
+	zassert_not_null(q, "couldn't alloc message queue");
+	zassert_false(k_msgq_alloc_init(q, MSG_SIZE, BATCH_LEN), NULL);
+
+	batch_put_get(q);
+	batch_put_to_reader(q, K_USER | K_INHERIT_PERMS);
+}
+#endif
+
+/**
+ * @}
+ */
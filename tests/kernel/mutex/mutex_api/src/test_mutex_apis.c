@@ -140,6 +140,49 @@ void test_mutex_lock_unlock(void)
 	tmutex_test_lock_unlock(&kmutex);
 }
 
+#ifdef CONFIG_MUTEX_ADAPTIVE_SPIN
+static K_SEM_DEFINE(hold_sem, 0, 1);
+
+static void tThread_entry_hold_busy(void *p1, void *p2, void *p3)
+{
+	k_mutex_lock((struct k_mutex *)p1, K_FOREVER);
+	k_sem_give(&hold_sem);
+	k_busy_wait(2 * TIMEOUT * USEC_PER_MSEC);
+	k_mutex_unlock((struct k_mutex *)p1);
+}
+
+/* The owner keeps running on the other CPU for longer than the
+ * caller's timeout: spinning must count against that timeout.
+ */
+void test_mutex_spin_timeout(void)
+{
+	s64_t start;
+
+	if (CONFIG_MP_NUM_CPUS < 2) {
+		ztest_test_skip();
+	}
+
+	k_mutex_init(&mutex);
+	k_thread_create(&tdata, tstack, STACK_SIZE,
+			tThread_entry_hold_busy, &mutex, NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_sem_take(&hold_sem, K_FOREVER);
+
+	start = k_uptime_get();
+	zassert_equal(k_mutex_lock(&mutex, K_MSEC(TIMEOUT / 10)), -EAGAIN,
+		      "locked a mutex held past the timeout");
+	zassert_true(k_uptime_get() - start < TIMEOUT,
+		     "spun past the timeout");
+
+	k_thread_join(&tdata, K_FOREVER);
+}
+#else
+void test_mutex_spin_timeout(void)
+{
+	ztest_test_skip();
+}
+#endif
+
 /*test case main entry*/
 void test_main(void)
 {
@@ -151,7 +194,8 @@ void test_main(void)
 			 ztest_1cpu_user_unit_test(test_mutex_reent_lock_forever),
 			 ztest_user_unit_test(test_mutex_reent_lock_no_wait),
 			 ztest_user_unit_test(test_mutex_reent_lock_timeout_fail),
-			 ztest_1cpu_user_unit_test(test_mutex_reent_lock_timeout_pass)
+			 ztest_1cpu_user_unit_test(test_mutex_reent_lock_timeout_pass),
+			 ztest_unit_test(test_mutex_spin_timeout)
 			 );
 	ztest_run_test_suite(mutex_api);
 }
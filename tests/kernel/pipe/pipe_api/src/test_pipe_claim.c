@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief Tests for the Pipe zero-copy claim / finish interface
+ * @ingroup kernel_pipe_tests
+ * @{
+ */
+
+#include <ztest.h>
+
+#define PIPE_LEN 8
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define TIMEOUT K_MSEC(100)
+
+static unsigned char __aligned(4) claim_buf[PIPE_LEN];
+static struct k_pipe claim_pipe;
+
+static K_THREAD_STACK_DEFINE(claim_stack, STACK_SIZE);
+static struct k_thread claim_thread;
+static unsigned char rx[PIPE_LEN];
+static size_t rx_len;
+static int xfer_ret;
+
+/**
+ * @brief Test writing and reading a pipe in place
+ *
+ * @see k_pipe_put_claim(), k_pipe_put_finish(), k_pipe_get_claim(),
+ * k_pipe_get_finish()
+ */
+void test_pipe_claim_finish(void)
+{
+	unsigned char out[PIPE_LEN];
+	size_t claimed, n;
+	u8_t *p;
+
+	k_pipe_init(&claim_pipe, claim_buf, sizeof(claim_buf));
+
+	zassert_equal(k_pipe_put_claim(&claim_pipe, &p, 4, &claimed, 5,
+				       K_NO_WAIT), -EINVAL, NULL);
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &p, 4, &claimed, 1,
+				       K_NO_WAIT), -EIO, NULL);
+
+	/**TESTPOINT: space is claimed at the head of an empty buffer */
+	zassert_equal(k_pipe_put_claim(&claim_pipe, &p, 6, &claimed, 6,
+				       K_NO_WAIT), 0, NULL);
+	zassert_equal(claimed, 6, NULL);
+	zassert_equal(p, claim_buf, NULL);
+	zassert_equal(k_pipe_write_avail(&claim_pipe), 2, NULL);
+
+	/**TESTPOINT: other writers are refused while a claim is open */
+	zassert_equal(k_pipe_put(&claim_pipe, "x", 1, &n, 1, K_NO_WAIT),
+		      -EBUSY, NULL);
+	zassert_equal(k_pipe_put_claim(&claim_pipe, &p, 1, &claimed, 1,
+				       K_NO_WAIT), -EBUSY, NULL);
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 0, NULL);
+
+	memcpy(claim_buf, "abcde", 5);
+	zassert_equal(k_pipe_put_finish(&claim_pipe, 7), -EINVAL, NULL);
+	zassert_equal(k_pipe_put_finish(&claim_pipe, 5), 0, NULL);
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 5, NULL);
+
+	/**TESTPOINT: data is read in place, partially released */
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &p, PIPE_LEN, &claimed, 1,
+				       K_NO_WAIT), 0, NULL);
+	zassert_equal(claimed, 5, NULL);
+	zassert_equal(memcmp(p, "abcde", 5), 0, NULL);
+	zassert_equal(k_pipe_get(&claim_pipe, out, 1, &n, 1, K_NO_WAIT),
+		      -EBUSY, NULL);
+	zassert_equal(k_pipe_get_finish(&claim_pipe, 3), 0, NULL);
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 2, NULL);
+
+	/**TESTPOINT: a claim stops at the end of the buffer */
+	zassert_equal(k_pipe_put_claim(&claim_pipe, &p, 4, &claimed, 4,
+				       K_NO_WAIT), 0, NULL);
+	zassert_equal(claimed, 3, "claim crossed the end of the buffer");
+	memcpy(p, "fgh", 3);
+	zassert_equal(k_pipe_put_finish(&claim_pipe, 3), 0, NULL);
+
+	zassert_equal(k_pipe_get(&claim_pipe, out, sizeof(out), &n, 5,
+				 K_NO_WAIT), 0, NULL);
+	zassert_equal(n, 5, NULL);
+	zassert_equal(memcmp(out, "defgh", 5), 0, NULL);
+}
+
+static void reader_entry(void *p1, void *p2, void *p3)
+{
+	zassert_equal(k_pipe_get(&claim_pipe, rx, 4, &rx_len, 4, K_FOREVER),
+		      0, NULL);
+}
+
+static void claimer_entry(void *p1, void *p2, void *p3)
+{
+	u8_t *p;
+
+	zassert_equal(k_pipe_put_claim(&claim_pipe, &p, PIPE_LEN, &rx_len,
+				       1, K_FOREVER), 0, NULL);
+	zassert_equal(k_pipe_put_finish(&claim_pipe, 0), 0, NULL);
+}
+
+/**
+ * @brief Test that claims cooperate with blocked readers and writers
+ *
+ * @see k_pipe_put_claim(), k_pipe_put_finish(), k_pipe_get_claim(),
+ * k_pipe_get_finish()
+ */
+void test_pipe_claim_wait(void)
+{
+	size_t claimed, n;
+	u8_t *p;
+
+	k_pipe_init(&claim_pipe, claim_buf, sizeof(claim_buf));
+
+	/**TESTPOINT: committed data goes to a blocked reader */
+	k_thread_create(&claim_thread, claim_stack, STACK_SIZE, reader_entry,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_sleep(K_MSEC(10));
+
+	zassert_equal(k_pipe_put_claim(&claim_pipe, &p, 6, &claimed, 6,
+				       K_NO_WAIT), 0, NULL);
+	memcpy(p, "012345", 6);
+	zassert_equal(k_pipe_put_finish(&claim_pipe, 6), 0, NULL);
+	k_thread_join(&claim_thread, K_FOREVER);
+	zassert_equal(rx_len, 4, NULL);
+	zassert_equal(memcmp(rx, "0123", 4), 0, NULL);
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 2, NULL);
+
+	/**TESTPOINT: a blocked claim wakes when space is released */
+	zassert_equal(k_pipe_put(&claim_pipe, "abcdef", 6, &n, 6, K_NO_WAIT),
+		      0, NULL);
+	zassert_equal(k_pipe_put_claim(&claim_pipe, &p, PIPE_LEN, &claimed,
+				       1, TIMEOUT), -EAGAIN, NULL);
+
+	rx_len = 0;
+	k_thread_create(&claim_thread, claim_stack, STACK_SIZE, claimer_entry,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_sleep(K_MSEC(10));
+	zassert_equal(rx_len, 0, NULL);
+
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &p, PIPE_LEN, &claimed, 1,
+				       K_NO_WAIT), 0, NULL);
+	zassert_equal(claimed, 4, NULL);
+	zassert_equal(memcmp(p, "45ab", 4), 0, NULL);
+	zassert_equal(k_pipe_get_finish(&claim_pipe, claimed), 0, NULL);
+	k_thread_join(&claim_thread, K_FOREVER);
+	zassert_equal(rx_len, 4, NULL);
+
+	zassert_equal(k_pipe_get(&claim_pipe, rx, sizeof(rx), &n, 1,
+				 K_NO_WAIT), 0, NULL);
+	zassert_equal(n, 4, NULL);
+	zassert_equal(memcmp(rx, "cdef", 4), 0, NULL);
+}
+
+static void writer_entry(void *p1, void *p2, void *p3)
+{
+	size_t n;
+
+	xfer_ret = k_pipe_put(&claim_pipe, "xy", 2, &n, 2, K_FOREVER);
+}
+
+static void short_reader_entry(void *p1, void *p2, void *p3)
+{
+	xfer_ret = k_pipe_get(&claim_pipe, rx, 2, &rx_len, 2, K_FOREVER);
+}
+
+/**
+ * @brief Test that transfers wait for an open claim to be finished
+ *
+ * @see k_pipe_put_claim(), k_pipe_put_finish(), k_pipe_get_claim(),
+ * k_pipe_get_finish(), k_pipe_put(), k_pipe_get()
+ */
+void test_pipe_claim_block(void)
+{
+	unsigned char out[PIPE_LEN];
+	size_t claimed, n;
+	u8_t *p;
+
+	k_pipe_init(&claim_pipe, claim_buf, sizeof(claim_buf));
+
+	zassert_equal(k_pipe_put_claim(&claim_pipe, &p, 2, &claimed, 2,
+				       K_NO_WAIT), 0, NULL);
+
+	/**TESTPOINT: a writer times out while the claim stays open */
+	zassert_equal(k_pipe_put(&claim_pipe, "x", 1, &n, 1, TIMEOUT),
+		      -EAGAIN, NULL);
+	zassert_equal(n, 0, NULL);
+
+	/**TESTPOINT: a blocked writer goes after the claimed data */
+	xfer_ret = -EINVAL;
+	k_thread_create(&claim_thread, claim_stack, STACK_SIZE, writer_entry,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_sleep(K_MSEC(10));
+	zassert_equal(xfer_ret, -EINVAL, "writer overtook the claim");
+
+	memcpy(p, "ab", 2);
+	zassert_equal(k_pipe_put_finish(&claim_pipe, 2), 0, NULL);
+	k_thread_join(&claim_thread, K_FOREVER);
+	zassert_equal(xfer_ret, 0, NULL);
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 4, NULL);
+
+	/**TESTPOINT: a blocked reader goes after the claimed data */
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &p, 2, &claimed, 2,
+				       K_NO_WAIT), 0, NULL);
+	zassert_equal(k_pipe_get(&claim_pipe, out, 1, &n, 1, TIMEOUT),
+		      -EAGAIN, NULL);
+
+	xfer_ret = -EINVAL;
+	k_thread_create(&claim_thread, claim_stack, STACK_SIZE,
+			short_reader_entry, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_sleep(K_MSEC(10));
+	zassert_equal(xfer_ret, -EINVAL, "reader overtook the claim");
+
+	zassert_equal(memcmp(p, "ab", 2), 0, NULL);
+	zassert_equal(k_pipe_get_finish(&claim_pipe, 2), 0, NULL);
+	k_thread_join(&claim_thread, K_FOREVER);
+	zassert_equal(xfer_ret, 0, NULL);
+	zassert_equal(rx_len, 2, NULL);
+	zassert_equal(memcmp(rx, "xy", 2), 0, NULL);
+}
+
+/**
+ * @}
+ */
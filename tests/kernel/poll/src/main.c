@@ -13,6 +13,9 @@ extern void test_poll_cancel_main_high_prio(void);
 extern void test_poll_multi(void);
 extern void test_poll_threadstate(void);
 extern void test_poll_grant_access(void);
+extern void test_poll_set(void);
+extern void test_poll_set_user(void);
+extern void test_poll_set_grant_access(void);
 
 #ifdef CONFIG_64BIT
 #define MAX_SZ	256
@@ -26,6 +29,7 @@ K_MEM_POOL_DEFINE(test_pool, 128, MAX_SZ, 4, 4);
 void test_main(void)
 {
 	test_poll_grant_access();
+	test_poll_set_grant_access();
 
 	k_thread_resource_pool_assign(k_current_get(), &test_pool);
 
@@ -36,6 +40,8 @@ void test_main(void)
 			 ztest_1cpu_unit_test(test_poll_cancel_main_low_prio),
 			 ztest_1cpu_unit_test(test_poll_cancel_main_high_prio),
 			 ztest_unit_test(test_poll_multi),
-			 ztest_1cpu_unit_test(test_poll_threadstate));
+			 ztest_1cpu_unit_test(test_poll_threadstate),
+			 ztest_1cpu_unit_test(test_poll_set),
+			 ztest_user_unit_test(test_poll_set_user));
 	ztest_run_test_suite(poll_api);
 }
@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <kernel.h>
+
+#define SET_SIZE 3
+#define TAG_SEM 1
+#define TAG_FIFO 2
+#define TAG_SIGNAL 3
+
+struct fifo_msg {
+	void *private;
+	u32_t msg;
+};
+
+K_POLL_SET_DEFINE(test_set, SET_SIZE);
+K_SEM_DEFINE(set_sem, 0, 1);
+K_FIFO_DEFINE(set_fifo);
+static struct k_poll_signal set_signal;
+static struct k_sem set_extra_sem;
+
+K_POLL_SET_DEFINE(user_set, 2);
+K_SEM_DEFINE(user_sem, 0, 1);
+static struct k_poll_signal user_signal;
+
+static void user_timer_expire(struct k_timer *timer)
+{
+	k_sem_give(&user_sem);
+}
+
+K_TIMER_DEFINE(user_timer, user_timer_expire, NULL);
+
+static int find_tag(struct k_poll_event *events, int n, int tag)
+{
+	for (int i = 0; i < n; i++) {
+		if (events[i].tag == tag) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+/**
+ * @brief Test persistent poll sets
+ *
+ * Adds a semaphore, a FIFO and a poll signal to a poll set once, and
+ * checks that k_poll_set_wait() reports them as they become available,
+ * keeps reporting them while they stay available, reports more ready
+ * events than fit in the caller's array round-robin, and stops
+ * reporting removed objects.
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_add(), k_poll_set_remove(), k_poll_set_wait()
+ */
+void test_poll_set(void)
+{
+	struct fifo_msg msg = { NULL, 0 };
+	struct k_poll_event ready[SET_SIZE];
+	int rc, i;
+
+	k_poll_signal_init(&set_signal);
+	k_sem_init(&set_extra_sem, 0, 1);
+
+	zassert_equal(k_poll_set_add(&test_set, K_POLL_TYPE_SEM_AVAILABLE,
+				     &set_sem, TAG_SEM), 0, NULL);
+	zassert_equal(k_poll_set_add(&test_set, K_POLL_TYPE_FIFO_DATA_AVAILABLE,
+				     &set_fifo, TAG_FIFO), 0, NULL);
+	zassert_equal(k_poll_set_add(&test_set, K_POLL_TYPE_SIGNAL,
+				     &set_signal, TAG_SIGNAL), 0, NULL);
+	zassert_equal(k_poll_set_add(&test_set, K_POLL_TYPE_SEM_AVAILABLE,
+				     &set_sem, TAG_SEM), -EALREADY, NULL);
+	zassert_equal(k_poll_set_add(&test_set, K_POLL_TYPE_SEM_AVAILABLE,
+				     &set_extra_sem, 0), -ENOMEM, NULL);
+
+	rc = k_poll_set_wait(&test_set, ready, SET_SIZE, K_NO_WAIT);
+	zassert_equal(rc, -EAGAIN, NULL);
+
+	/* TESTPOINT: an object becoming available readies its event */
+	k_sem_give(&set_sem);
+	rc = k_poll_set_wait(&test_set, ready, SET_SIZE, K_NO_WAIT);
+	zassert_equal(rc, 1, NULL);
+	zassert_equal(ready[0].tag, TAG_SEM, NULL);
+	zassert_equal(ready[0].state, K_POLL_STATE_SEM_AVAILABLE, NULL);
+	zassert_equal_ptr(ready[0].obj, &set_sem, NULL);
+
+	/* TESTPOINT: readiness is level-triggered */
+	rc = k_poll_set_wait(&test_set, ready, SET_SIZE, K_NO_WAIT);
+	zassert_equal(rc, 1, NULL);
+	zassert_equal(k_sem_take(&set_sem, K_NO_WAIT), 0, NULL);
+	rc = k_poll_set_wait(&test_set, ready, SET_SIZE, K_NO_WAIT);
+	zassert_equal(rc, -EAGAIN, NULL);
+
+	/* TESTPOINT: ready events beyond the caller's array are
+	 * reported round-robin
+	 */
+	k_fifo_put(&set_fifo, &msg);
+	k_poll_signal_raise(&set_signal, 0);
+
+	rc = k_poll_set_wait(&test_set, ready, 1, K_NO_WAIT);
+	zassert_equal(rc, 1, NULL);
+	rc = k_poll_set_wait(&test_set, &ready[1], 1, K_NO_WAIT);
+	zassert_equal(rc, 1, NULL);
+	zassert_not_equal(ready[0].tag, ready[1].tag, NULL);
+
+	rc = k_poll_set_wait(&test_set, ready, SET_SIZE, K_NO_WAIT);
+	zassert_equal(rc, 2, NULL);
+	i = find_tag(ready, rc, TAG_FIFO);
+	zassert_true(i >= 0, NULL);
+	zassert_equal(ready[i].state, K_POLL_STATE_FIFO_DATA_AVAILABLE, NULL);
+	i = find_tag(ready, rc, TAG_SIGNAL);
+	zassert_true(i >= 0, NULL);
+	zassert_equal(ready[i].state, K_POLL_STATE_SIGNALED, NULL);
+
+	zassert_equal_ptr(k_fifo_get(&set_fifo, K_NO_WAIT), &msg, NULL);
+	k_poll_signal_reset(&set_signal);
+	rc = k_poll_set_wait(&test_set, ready, SET_SIZE, K_NO_WAIT);
+	zassert_equal(rc, -EAGAIN, NULL);
+
+	/* TESTPOINT: removed objects are no longer reported, and free
+	 * their slot
+	 */
+	zassert_equal(k_poll_set_remove(&test_set, &set_sem), 0, NULL);
+	zassert_equal(k_poll_set_remove(&test_set, &set_sem), -ENOENT, NULL);
+	k_sem_give(&set_sem);
+	rc = k_poll_set_wait(&test_set, ready, SET_SIZE, K_NO_WAIT);
+	zassert_equal(rc, -EAGAIN, NULL);
+
+	zassert_equal(k_poll_set_add(&test_set, K_POLL_TYPE_SEM_AVAILABLE,
+				     &set_extra_sem, 0), 0, NULL);
+	k_sem_give(&set_extra_sem);
+	rc = k_poll_set_wait(&test_set, ready, SET_SIZE, K_NO_WAIT);
+	zassert_equal(rc, 1, NULL);
+	zassert_equal_ptr(ready[0].obj, &set_extra_sem, NULL);
+
+	zassert_equal(k_poll_set_remove(&test_set, &set_extra_sem), 0, NULL);
+	zassert_equal(k_poll_set_remove(&test_set, &set_fifo), 0, NULL);
+	zassert_equal(k_poll_set_remove(&test_set, &set_signal), 0, NULL);
+	k_sem_reset(&set_sem);
+}
+
+/**
+ * @brief Test waiting on a poll set from user mode
+ *
+ * Checks that k_poll_set_wait() times out when nothing is ready, and
+ * that a waiting thread is woken when an object of the set becomes
+ * available from an ISR.
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_add(), k_poll_set_wait()
+ */
+void test_poll_set_user(void)
+{
+	struct k_poll_event ready[2];
+	int rc;
+
+	zassert_equal(k_poll_set_add(&user_set, K_POLL_TYPE_SEM_AVAILABLE,
+				     &user_sem, TAG_SEM), 0, NULL);
+	zassert_equal(k_poll_set_add(&user_set, K_POLL_TYPE_SIGNAL,
+				     &user_signal, TAG_SIGNAL), 0, NULL);
+
+	rc = k_poll_set_wait(&user_set, ready, ARRAY_SIZE(ready), K_MSEC(50));
+	zassert_equal(rc, -EAGAIN, NULL);
+
+	k_timer_start(&user_timer, K_MSEC(50), K_NO_WAIT);
+	rc = k_poll_set_wait(&user_set, ready, ARRAY_SIZE(ready), K_FOREVER);
+	zassert_equal(rc, 1, NULL);
+	zassert_equal(ready[0].tag, TAG_SEM, NULL);
+	zassert_equal(k_sem_take(&user_sem, K_NO_WAIT), 0, NULL);
+
+	k_poll_signal_raise(&user_signal, 0);
+	rc = k_poll_set_wait(&user_set, ready, ARRAY_SIZE(ready), K_FOREVER);
+	zassert_equal(rc, 1, NULL);
+	zassert_equal(ready[0].tag, TAG_SIGNAL, NULL);
+	k_poll_signal_reset(&user_signal);
+
+	zassert_equal(k_poll_set_remove(&user_set, &user_sem), 0, NULL);
+	zassert_equal(k_poll_set_remove(&user_set, &user_signal), 0, NULL);
+}
+
+void test_poll_set_grant_access(void)
+{
+	k_poll_signal_init(&user_signal);
+
+	k_thread_access_grant(k_current_get(), &user_set, &user_sem,
+			      &user_signal, &user_timer);
+}
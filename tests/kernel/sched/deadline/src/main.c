@@ -90,9 +90,87 @@ void test_deadline(void)
 	}
 }
 
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+#define CBS_PERIOD_TICKS 4
+
+static struct k_thread cbs_threads[2];
+static K_THREAD_STACK_ARRAY_DEFINE(cbs_stacks, 2, STACK_SIZE);
+static volatile u32_t cbs_count[2];
+
+static void cbs_worker(void *p1, void *p2, void *p3)
+{
+	int idx = POINTER_TO_INT(p1);
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	/* Never block: without budgets, the thread with the earliest
+	 * deadline would starve the other one.
+	 */
+	while (1) {
+		cbs_count[idx]++;
+		k_busy_wait(50);
+	}
+}
+#endif
+
+/**
+ * @brief Test CBS runtime budgets
+ *
+ * Runs two CPU bound threads at the same priority, with budgets of one
+ * and three ticks out of the same period, and checks that both get to
+ * run and the CPU is shared according to their budgets.
+ *
+ * @see k_thread_deadline_budget_set()
+ */
+void test_deadline_budget(void)
+{
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	int period = k_ticks_to_cyc_floor32(CBS_PERIOD_TICKS);
+	int i;
+
+	for (i = 0; i < 2; i++) {
+		k_thread_create(&cbs_threads[i],
+				cbs_stacks[i], STACK_SIZE,
+				cbs_worker, INT_TO_POINTER(i), NULL, NULL,
+				K_LOWEST_APPLICATION_THREAD_PRIO,
+				0, K_FOREVER);
+	}
+
+	k_thread_deadline_budget_set(&cbs_threads[0],
+				     k_ticks_to_cyc_floor32(1), period);
+	k_thread_deadline_budget_set(&cbs_threads[1],
+				     k_ticks_to_cyc_floor32(3), period);
+
+	for (i = 0; i < 2; i++) {
+		k_thread_start(&cbs_threads[i]);
+	}
+
+	k_sleep(K_TICKS(40 * CBS_PERIOD_TICKS));
+
+	for (i = 0; i < 2; i++) {
+		k_thread_abort(&cbs_threads[i]);
+	}
+
+	zassert_true(cbs_count[0] > 0U, "first thread starved");
+	zassert_true(cbs_count[1] > 0U, "second thread starved");
+
+	/* 1:3 split, with some slack for the tick granularity */
+	zassert_true(cbs_count[0] * 2U < cbs_count[1],
+		     "budgets not enforced (%u vs %u)",
+		     cbs_count[0], cbs_count[1]);
+	zassert_true(cbs_count[0] * 4U > cbs_count[1],
+		     "budgets not enforced (%u vs %u)",
+		     cbs_count[0], cbs_count[1]);
+#else
+	ztest_test_skip();
+#endif
+}
+
 void test_main(void)
 {
 	ztest_test_suite(suite_deadline,
-			 ztest_unit_test(test_deadline));
+			 ztest_unit_test(test_deadline),
+			 ztest_unit_test(test_deadline_budget));
 	ztest_run_test_suite(suite_deadline);
 }
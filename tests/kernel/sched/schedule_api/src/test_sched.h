@@ -41,6 +41,8 @@ void test_unlock_nested_sched_lock(void);
 void test_sched_is_preempt_thread(void);
 void test_slice_reset(void);
 void test_slice_scheduling(void);
+void test_slice_expiry(void);
+void test_slice_perthread(void);
 void test_priority_scheduling(void);
 void test_wakeup_expired_timer_thread(void);
 void test_user_k_wakeup(void);
@@ -136,9 +136,147 @@ void test_slice_scheduling(void)
 	k_thread_priority_set(k_current_get(), old_prio);
 }
 
+#ifdef CONFIG_TIMESLICE_PER_THREAD
+/* per-thread slices of 20 and 60 ms */
+#define SHORT_SLICE 20
+#define LONG_SLICE 60
+
+static volatile u32_t slice_runs[2];
+static u32_t slice_expired[2];
+
+static void slice_expired_cb(struct k_thread *thread, void *data)
+{
+	int idx = POINTER_TO_INT(data);
+
+	zassert_equal_ptr(thread, &t[idx], NULL);
+	slice_expired[idx]++;
+}
+
+static void thread_slice_spin(void *p1, void *p2, void *p3)
+{
+	int idx = POINTER_TO_INT(p1);
+
+	while (1) {
+		slice_runs[idx]++;
+		k_busy_wait(100);
+	}
+}
+
+/**
+ * @brief Check per-thread time slices
+ *
+ * @details Run two busy preemptive threads of the same priority, with
+ * per-thread slices of different lengths and time slicing otherwise
+ * disabled.  Check that the threads alternate, that the expiration
+ * callbacks are invoked, and that each thread gets CPU time in
+ * proportion to its slice.
+ *
+ * @ingroup kernel_sched_tests
+ */
+void test_slice_perthread(void)
+{
+	int old_prio = k_thread_priority_get(k_current_get());
+	s32_t slices[2] = { SHORT_SLICE, LONG_SLICE };
+
+	k_sched_time_slice_set(0, K_PRIO_PREEMPT(0));
+	k_thread_priority_set(k_current_get(), K_PRIO_PREEMPT(BASE_PRIORITY));
+
+	for (int i = 0; i < 2; i++) {
+		k_thread_create(&t[i], tstacks[i], STACK_SIZE,
+				thread_slice_spin, INT_TO_POINTER(i), NULL,
+				NULL, K_PRIO_PREEMPT(BASE_PRIORITY + 1), 0,
+				K_FOREVER);
+		k_thread_time_slice_set(&t[i], slices[i], slice_expired_cb,
+					INT_TO_POINTER(i));
+		k_thread_start(&t[i]);
+	}
+
+	/* four rounds of both slices */
+	k_sleep(K_MSEC(4 * (SHORT_SLICE + LONG_SLICE)));
+
+	for (int i = 0; i < 2; i++) {
+		k_thread_abort(&t[i]);
+	}
+
+	zassert_true(slice_expired[0] >= 2U && slice_expired[1] >= 2U,
+		     "slices did not expire (%u, %u)",
+		     slice_expired[0], slice_expired[1]);
+	zassert_true(slice_runs[0] * 2U < slice_runs[1],
+		     "slice lengths not honoured (%u vs %u)",
+		     slice_runs[0], slice_runs[1]);
+
+	k_thread_priority_set(k_current_get(), old_prio);
+}
+#else
+void test_slice_perthread(void)
+{
+	ztest_test_skip();
+}
+#endif /* CONFIG_TIMESLICE_PER_THREAD */
+
+/* Slice of the expiry test, long enough for the other thread to only
+ * run if the slice ends on time
+ */
+#define EXPIRY_SLICE_MS 100
+
+static volatile s64_t expiry_ran_at;
+
+static void thread_slice_expiry(void *p1, void *p2, void *p3)
+{
+	expiry_ran_at = k_uptime_get();
+}
+
+/**
+ * @brief Check that a time slice ends with its own timer interrupt
+ *
+ * @details Enable time slicing right after a tick, with no other
+ * timeout pending, and keep the CPU busy while a thread of the same
+ * priority is ready.  In a tickless kernel, nothing but the timer
+ * programmed for the slice can then switch to the other thread.
+ *
+ * @ingroup kernel_sched_tests
+ */
+void test_slice_expiry(void)
+{
+	int old_prio = k_thread_priority_get(k_current_get());
+	k_tid_t tid;
+	s64_t start;
+
+	k_thread_priority_set(k_current_get(), K_PRIO_PREEMPT(BASE_PRIORITY));
+	expiry_ran_at = 0;
+
+	k_usleep(1); /* align to tick */
+
+	start = k_uptime_get();
+	k_sched_time_slice_set(EXPIRY_SLICE_MS, K_PRIO_PREEMPT(BASE_PRIORITY));
+	tid = k_thread_create(&t[0], tstacks[0], STACK_SIZE,
+			      thread_slice_expiry, NULL, NULL, NULL,
+			      K_PRIO_PREEMPT(BASE_PRIORITY), 0, K_NO_WAIT);
+
+	spin_for_ms(3 * EXPIRY_SLICE_MS);
+
+	k_sched_time_slice_set(0, K_PRIO_PREEMPT(0));
+	k_thread_abort(tid);
+	k_thread_priority_set(k_current_get(), old_prio);
+
+	zassert_true(expiry_ran_at != 0, "time slice did not expire");
+	zassert_true(expiry_ran_at - start < 2 * EXPIRY_SLICE_MS,
+		     "time slice expired late");
+}
+
 #else /* CONFIG_TIMESLICING */
 void test_slice_scheduling(void)
 {
 	ztest_test_skip();
 }
+
+void test_slice_expiry(void)
+{
+	ztest_test_skip();
+}
+
+void test_slice_perthread(void)
+{
+	ztest_test_skip();
+}
 #endif /* CONFIG_TIMESLICING */
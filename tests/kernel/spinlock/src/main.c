@@ -18,6 +18,12 @@ struct k_thread cpu1_thread;
 
 static struct k_spinlock bounce_lock;
 
+#ifdef CONFIG_SPINLOCK_TICKET
+#define LOCK_HELD(l) ((l).next != (l).owner)
+#else
+#define LOCK_HELD(l) ((l).locked)
+#endif
+
 volatile int bounce_owner, bounce_done;
 
 /**
@@ -43,15 +49,20 @@ void test_spinlock_basic(void)
 	k_spinlock_key_t key;
 	static struct k_spinlock l;
 
-	zassert_true(!l.locked, "Spinlock initialized to locked");
+	zassert_true(!LOCK_HELD(l), "Spinlock initialized to locked");
 
 	key = k_spin_lock(&l);
 
-	zassert_true(l.locked, "Spinlock failed to lock");
+	zassert_true(LOCK_HELD(l), "Spinlock failed to lock");
 
 	k_spin_unlock(&l, key);
 
-	zassert_true(!l.locked, "Spinlock failed to unlock");
+	zassert_true(!LOCK_HELD(l), "Spinlock failed to unlock");
+
+#ifdef CONFIG_SPINLOCK_STATS
+	zassert_equal(l.acquired, 1, "Acquisition not counted");
+	zassert_equal(l.contended, 0, "Uncontended acquisition counted");
+#endif
 }
 
 void bounce_once(int id)
@@ -127,6 +138,14 @@ void test_spinlock_bounce(void)
 	}
 
 	bounce_done = 1;
+
+#ifdef CONFIG_SPINLOCK_STATS
+	zassert_true(bounce_lock.acquired >= 10000, "Acquisitions not counted");
+	zassert_true(bounce_lock.contended <= bounce_lock.acquired,
+		     "Contentions miscounted");
+	zassert_true(bounce_lock.spins >= bounce_lock.contended,
+		     "Spins miscounted");
+#endif
 }
 
 void test_main(void)
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <ztest.h>
+#include <kernel.h>
+
+#include "tests_thread_apis.h"
+
+#define BUSY_US 20000
+
+static struct k_thread stats_thread;
+static K_THREAD_STACK_DEFINE(stats_stack, 512 + CONFIG_TEST_EXTRA_STACKSIZE);
+
+static void stats_fn(void *a, void *b, void *c)
+{
+	k_busy_wait(BUSY_US);
+}
+
+/**
+ * @brief Test per-thread runtime statistics
+ *
+ * Runs a thread that busy-waits for a known time and checks that it is
+ * charged for at least that time, that its switch and wakeup latency
+ * counts are updated, and that the statistics of the running thread
+ * include its current run.
+ *
+ * @ingroup kernel_thread_tests
+ *
+ * @see k_thread_runtime_stats_get()
+ */
+void test_threads_runtime_stats(void)
+{
+#ifdef CONFIG_THREAD_RUNTIME_STATS
+	struct k_thread_runtime_stats before, after;
+	u32_t woken = 0U;
+	k_tid_t tid;
+
+	zassert_equal(k_thread_runtime_stats_get(NULL, &before), -EINVAL,
+		      NULL);
+	zassert_equal(k_thread_runtime_stats_get(k_current_get(), NULL),
+		      -EINVAL, NULL);
+
+	/* TESTPOINT: a thread is charged for the time it ran */
+	tid = k_thread_create(&stats_thread, stats_stack,
+			      K_THREAD_STACK_SIZEOF(stats_stack), stats_fn,
+			      NULL, NULL, NULL,
+			      k_thread_priority_get(k_current_get()) - 1,
+			      0, K_NO_WAIT);
+	zassert_equal(k_thread_join(tid, K_FOREVER), 0, NULL);
+
+	zassert_equal(k_thread_runtime_stats_get(tid, &after), 0, NULL);
+	zassert_true(after.execution_cycles >=
+		     k_us_to_cyc_floor32(BUSY_US / 2), NULL);
+	zassert_true(after.switches >= 1U, NULL);
+
+	for (int i = 0; i < K_THREAD_LATENCY_BUCKETS; i++) {
+		woken += after.latency_hist[i];
+	}
+	zassert_true(woken >= 1U, NULL);
+
+	/* TESTPOINT: the current run of a thread is accounted */
+	zassert_equal(k_thread_runtime_stats_get(k_current_get(), &before), 0,
+		      NULL);
+	k_busy_wait(BUSY_US);
+	zassert_equal(k_thread_runtime_stats_get(k_current_get(), &after), 0,
+		      NULL);
+	zassert_true(after.execution_cycles - before.execution_cycles >=
+		     k_us_to_cyc_floor32(BUSY_US / 2), NULL);
+#else
+	ztest_test_skip();
+#endif
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <errno.h>
+
+#define N_THREADS 2
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define TLS_INIT_VALUE 0x600dcafe
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, N_THREADS, STACK_SIZE);
+static struct k_thread threads[N_THREADS];
+
+/* Together with errno, these make a thread local storage image whose
+ * size is not a multiple of the thread pointer alignment: the word is
+ * in tdata, and the byte and errno share tbss in an unspecified order.
+ */
+static __thread u32_t tls_word = TLS_INIT_VALUE;
+static __thread u8_t tls_byte;
+
+static void tls_thread(void *p1, void *p2, void *p3)
+{
+	u32_t n = POINTER_TO_UINT(p1);
+
+	zassert_equal(tls_word, TLS_INIT_VALUE, "tdata not initialized");
+	zassert_equal(tls_byte, 0, "tbss not zeroed");
+	zassert_equal(errno, 0, "errno not zeroed");
+
+	tls_word = n;
+	tls_byte = (u8_t)(n + 1);
+	errno = n + 2;
+
+	k_msleep(10);
+
+	zassert_equal(tls_word, n, NULL);
+	zassert_equal(tls_byte, (u8_t)(n + 1), NULL);
+	zassert_equal(errno, n + 2, NULL);
+}
+
+/**
+ * @brief Test thread local variables in an odd-sized image
+ *
+ * The thread local variables of new threads must start with their
+ * initial values, and keep the values each thread writes, wherever the
+ * linker put them relative to the thread pointer.
+ *
+ * @see arch_tls_stack_setup()
+ */
+void test_tls_odd_size(void)
+{
+	int i;
+
+	for (i = 0; i < N_THREADS; i++) {
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE,
+				tls_thread, UINT_TO_POINTER(i), NULL, NULL,
+				K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	}
+
+	for (i = 0; i < N_THREADS; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+
+	zassert_equal(tls_word, TLS_INIT_VALUE, NULL);
+	zassert_equal(tls_byte, 0, NULL);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(tls,
+			 ztest_unit_test(test_tls_odd_size));
+	ztest_run_test_suite(tls);
+}
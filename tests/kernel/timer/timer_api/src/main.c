@@ -34,8 +34,11 @@ static struct k_timer status_timer;
 static struct k_timer status_anytime_timer;
 static struct k_timer status_sync_timer;
 static struct k_timer remain_timer;
+static struct k_timer slack_timer;
+static struct k_timer slack_deadline_timer;
 
 static ZTEST_BMEM struct timer_data tdata;
+static ZTEST_BMEM bool valid_fault;
 
 extern void test_time_conversions(void);
 
@@ -594,6 +597,79 @@ void test_timeout_abs(void)
 #endif
 }
 
+/**
+ * @brief Test timer slack
+ *
+ * Starts a timer with enough slack to be deferred until a second
+ * timer expires, and checks that with CONFIG_TIMEOUT_SLACK on a
+ * tickless kernel it does not expire at its nominal time but together
+ * with the second one, and that it always expires by then.
+ *
+ * @ingroup kernel_timer_tests
+ *
+ * @see k_timer_slack_set()
+ */
+void test_timer_slack(void)
+{
+	u32_t early;
+
+	k_timer_slack_set(&slack_timer, K_MSEC(2 * DURATION));
+
+	k_usleep(1); /* align to tick */
+
+	k_timer_start(&slack_timer, K_MSEC(DURATION), K_NO_WAIT);
+	k_timer_start(&slack_deadline_timer, K_MSEC(2 * DURATION), K_NO_WAIT);
+
+	busy_wait_ms(DURATION + DURATION / 2);
+	early = k_timer_status_get(&slack_timer);
+
+	if (IS_ENABLED(CONFIG_TIMEOUT_SLACK) &&
+	    IS_ENABLED(CONFIG_TICKLESS_KERNEL)) {
+		/* Nothing else should have woken us up in between */
+		zassert_equal(early, 0,
+			      "timer expired before the coalesced deadline");
+	}
+
+	zassert_equal(k_timer_status_sync(&slack_deadline_timer), 1, NULL);
+	zassert_equal(early + k_timer_status_get(&slack_timer), 1,
+		      "timer did not expire by the coalesced deadline");
+
+	k_timer_slack_set(&slack_timer, K_NO_WAIT);
+}
+
+void k_sys_fatal_error_handler(unsigned int reason, const z_arch_esf_t *esf)
+{
+	printk("Caught system error -- reason %d\n", reason);
+	if (valid_fault) {
+		valid_fault = false;
+		ztest_test_pass();
+	} else {
+		k_fatal_halt(reason);
+	}
+}
+
+/**
+ * @brief Test that user mode cannot set an absolute timer slack
+ *
+ * A slack is a duration, so passing an absolute timeout to
+ * k_timer_slack_set() from user mode must make the system call fail
+ * instead of reaching the kernel.
+ *
+ * @ingroup kernel_timer_tests
+ *
+ * @see k_timer_slack_set()
+ */
+void test_timer_slack_abs_user(void)
+{
+#if defined(CONFIG_USERSPACE) && defined(CONFIG_TIMEOUT_64BIT)
+	valid_fault = true;
+	k_timer_slack_set(&slack_timer, K_TIMEOUT_ABS_MS(1));
+	zassert_unreachable("absolute slack accepted from user mode");
+#else
+	ztest_test_skip();
+#endif
+}
+
 static void timer_init(struct k_timer *timer, k_timer_expiry_t expiry_fn,
 		       k_timer_stop_t stop_fn)
 {
@@ -612,6 +688,8 @@ void test_main(void)
 	timer_init(&status_anytime_timer, NULL, NULL);
 	timer_init(&status_sync_timer, duration_expire, duration_stop);
 	timer_init(&remain_timer, NULL, NULL);
+	timer_init(&slack_timer, NULL, NULL);
+	timer_init(&slack_deadline_timer, NULL, NULL);
 
 	k_thread_access_grant(k_current_get(), &ktimer, &timer0, &timer1,
 			      &timer2, &timer3, &timer4);
@@ -628,6 +706,8 @@ void test_main(void)
 			 ztest_user_unit_test(test_timer_k_define),
 			 ztest_user_unit_test(test_timer_user_data),
 			 ztest_user_unit_test(test_timer_remaining),
-			 ztest_user_unit_test(test_timeout_abs));
+			 ztest_user_unit_test(test_timeout_abs),
+			 ztest_user_unit_test(test_timer_slack),
+			 ztest_user_unit_test(test_timer_slack_abs_user));
 	ztest_run_test_suite(timer_api);
 }
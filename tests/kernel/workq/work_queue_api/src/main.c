@@ -861,6 +861,75 @@ void test_triggered_work_cancel_isr(void)
 	}
 }
 
+#define POOL_WORKERS 3
+
+K_WORK_Q_POOL_DEFINE(workq_pool, POOL_WORKERS, STACK_SIZE);
+static struct k_work pool_work[POOL_WORKERS], pool_resubmit_work;
+static struct k_sem pool_sema;
+static atomic_t pool_running, pool_runs;
+
+static void pool_sleepy(struct k_work *w)
+{
+	k_sleep(TIMEOUT);
+	k_sem_give(&pool_sema);
+}
+
+static void pool_exclusive(struct k_work *w)
+{
+	zassert_equal(atomic_inc(&pool_running), 0,
+		      "work item runs on two workers at once");
+	k_msleep(TIMEOUT_MS / 4);
+	atomic_inc(&pool_runs);
+	atomic_dec(&pool_running);
+	k_sem_give(&pool_sema);
+}
+
+/**
+ * @brief Test workqueue pools
+ *
+ * @details Submit as many sleeping work items as the pool has workers
+ * and check that they all complete in about the time of one, then
+ * resubmit a work item while it is running and check that it is run
+ * again, but never by two workers at once.
+ *
+ * @see K_WORK_Q_POOL_DEFINE(), k_work_q_pool_start()
+ */
+void test_work_q_pool(void)
+{
+	s64_t start;
+
+	k_sem_init(&pool_sema, 0, UINT_MAX);
+	k_work_q_pool_start(&workq_pool, k_thread_priority_get(main_thread),
+			    K_WORK_Q_POOL_PIN_CPUS);
+
+	start = k_uptime_get();
+	for (int i = 0; i < POOL_WORKERS; i++) {
+		k_work_init(&pool_work[i], pool_sleepy);
+		k_work_submit_to_queue(&workq_pool.work_q, &pool_work[i]);
+	}
+	for (int i = 0; i < POOL_WORKERS; i++) {
+		zassert_equal(k_sem_take(&pool_sema, K_MSEC(2 * TIMEOUT_MS)),
+			      0, NULL);
+	}
+	zassert_true(k_uptime_get() - start < 2 * TIMEOUT_MS,
+		     "work items did not run in parallel");
+
+	k_work_init(&pool_resubmit_work, pool_exclusive);
+	k_work_submit_to_queue(&workq_pool.work_q, &pool_resubmit_work);
+	for (int i = 0; i < POOL_WORKERS; i++) {
+		/* let it start, then queue it again behind the idle workers */
+		k_msleep(TIMEOUT_MS / 8);
+		k_work_submit_to_queue(&workq_pool.work_q,
+				       &pool_resubmit_work);
+		zassert_true(k_work_pending(&pool_resubmit_work), NULL);
+		zassert_equal(k_sem_take(&pool_sema, K_MSEC(TIMEOUT_MS)), 0,
+			      NULL);
+	}
+	zassert_equal(k_sem_take(&pool_sema, K_MSEC(TIMEOUT_MS)), 0, NULL);
+	zassert_false(k_work_pending(&pool_resubmit_work), NULL);
+	zassert_equal(atomic_get(&pool_runs), POOL_WORKERS + 1, NULL);
+}
+
 void test_main(void)
 {
 	main_thread = k_current_get();
@@ -902,6 +971,7 @@ void test_main(void)
 			 ztest_1cpu_unit_test(test_triggered_work_cancel_from_queue_thread),
 			 ztest_1cpu_unit_test(test_triggered_work_cancel_from_queue_isr),
 			 ztest_1cpu_unit_test(test_triggered_work_cancel_thread),
-			 ztest_1cpu_unit_test(test_triggered_work_cancel_isr));
+			 ztest_1cpu_unit_test(test_triggered_work_cancel_isr),
+			 ztest_unit_test(test_work_q_pool));
 	ztest_run_test_suite(workqueue_api);
 }
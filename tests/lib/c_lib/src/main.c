@@ -293,6 +293,90 @@ void test_memcmp(void)
 	zassert_true((ret != 0), "memcmp 5");
 }
 
+#define ALIGN_BUF_SIZE 80
+#define ALIGN_MAX_LEN 48
+
+static unsigned char align_src[ALIGN_BUF_SIZE] __aligned(8);
+static unsigned char align_dst[ALIGN_BUF_SIZE] __aligned(8);
+
+static void check_alignment(int s_off, int d_off, int len)
+{
+	/* Leave a word before the buffers to catch underruns */
+	unsigned char *src = align_src + 8 + s_off;
+	unsigned char *dst = align_dst + 8 + d_off;
+	int i;
+
+	for (i = 0; i < ALIGN_BUF_SIZE; i++) {
+		align_src[i] = (i * 7 + 1) & 0x7f;
+		align_dst[i] = 0xee;
+	}
+
+	zassert_equal_ptr(memcpy(dst, src, len), dst, "memcpy");
+	for (i = 0; i < len; i++) {
+		zassert_equal(dst[i], src[i], "memcpy %d %d %d",
+			      s_off, d_off, len);
+	}
+	zassert_equal(dst[len], 0xee, "memcpy overrun");
+	zassert_equal(dst[-1], 0xee, "memcpy underrun");
+
+	zassert_equal(memcmp(dst, src, len), 0, "memcmp");
+	if (len > 0) {
+		dst[len - 1] = 0x80;
+		src[len - 1] = 0x01;
+		zassert_true(memcmp(dst, src, len) > 0, "memcmp %d %d %d",
+			     s_off, d_off, len);
+	}
+
+	zassert_equal_ptr(memchr(src, 0xcc, len), NULL, "memchr");
+	if (len > 0) {
+		src[len - 1] = 0xcc;
+		zassert_equal_ptr(memchr(src, 0xcc, len), &src[len - 1],
+				  "memchr %d %d", s_off, len);
+	}
+
+	(void)memset(dst, 'x', len);
+	for (i = 0; i < len; i++) {
+		zassert_equal(dst[i], 'x', "memset");
+	}
+	zassert_equal(dst[len], 0xee, "memset overrun");
+	zassert_equal(dst[-1], 0xee, "memset underrun");
+
+	(void)memset(src, 'x', len);
+	src[len] = '\0';
+	dst[len] = '\0';
+	zassert_equal(strlen((char *)src), len, "strlen %d %d", s_off, len);
+	zassert_equal(strcmp((char *)dst, (char *)src), 0, "strcmp");
+	if (len > 0) {
+		dst[len - 1] = 0x80;
+		zassert_true(strcmp((char *)dst, (char *)src) > 0,
+			     "strcmp %d %d %d", s_off, d_off, len);
+	}
+}
+
+/**
+ *
+ * @brief Test memory and string functions on misaligned buffers
+ *
+ * The word at a time implementations take different paths depending on
+ * the alignment of each buffer and on the length, so check every
+ * combination of buffer offsets within a word against byte at a time
+ * results.
+ *
+ */
+
+void test_mem_str_alignment(void)
+{
+	int s_off, d_off, len;
+
+	for (s_off = 0; s_off < 8; s_off++) {
+		for (d_off = 0; d_off < 8; d_off++) {
+			for (len = 0; len <= ALIGN_MAX_LEN; len++) {
+				check_alignment(s_off, d_off, len);
+			}
+		}
+	}
+}
+
 /**
  *
  * @brief Test binary search function
@@ -328,6 +412,7 @@ void test_main(void)
 			 ztest_unit_test(test_stddef),
 			 ztest_unit_test(test_stdint),
 			 ztest_unit_test(test_memcmp),
+			 ztest_unit_test(test_mem_str_alignment),
 			 ztest_unit_test(test_strchr),
 			 ztest_unit_test(test_strcpy),
 			 ztest_unit_test(test_strncpy),
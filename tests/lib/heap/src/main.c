@@ -204,12 +204,230 @@ static void test_big_heap(void)
 	log_result(BIG_HEAP_SZ, &result);
 }
 
+/* Aligned allocations of every power of two up to 1/16 of the heap
+ * (the padding needed for the largest ones must still fit), on both
+ * heap formats, interleaved with plain ones so that the padding
+ * around them gets reused
+ */
+static void aligned_alloc_heap(size_t heap_sz)
+{
+	struct sys_heap heap;
+	void *p[11], *q[11];
+	int n = 0;
+
+	sys_heap_init(&heap, heapmem, heap_sz);
+
+	while (n < ARRAY_SIZE(p) && (1 << n) <= heap_sz / 16) {
+		n++;
+	}
+
+	for (int i = 0; i < n; i++) {
+		size_t align = 1 << i;
+
+		p[i] = sys_heap_aligned_alloc(&heap, align, 24 + i);
+		zassert_not_null(p[i], "aligned alloc %d failed", (int)align);
+		zassert_true(((uintptr_t)p[i] & (align - 1)) == 0,
+			     "%p not aligned to %d", p[i], (int)align);
+		fill_block(p[i], 24 + i);
+		q[i] = testalloc(&heap, 8 + i);
+		zassert_true(sys_heap_validate(&heap), "");
+	}
+
+	for (int i = 0; i < n; i++) {
+		testfree(&heap, p[i]);
+		testfree(&heap, q[i]);
+	}
+
+	zassert_true(sys_heap_validate(&heap), "");
+}
+
+static void test_aligned_alloc(void)
+{
+	aligned_alloc_heap(SMALL_HEAP_SZ);
+	aligned_alloc_heap(BIG_HEAP_SZ);
+}
+
+static void test_realloc(void)
+{
+	struct sys_heap heap;
+	u8_t *p, *p2, *blocker;
+
+	sys_heap_init(&heap, heapmem, SMALL_HEAP_SZ);
+
+	/* NULL reallocs like malloc, zero size frees */
+	p = sys_heap_realloc(&heap, NULL, 32);
+	zassert_not_null(p, "");
+	zassert_is_null(sys_heap_realloc(&heap, p, 0), "");
+	zassert_true(sys_heap_validate(&heap), "");
+
+	/* Growing into free space on the right stays in place */
+	p = sys_heap_alloc(&heap, 32);
+	for (int i = 0; i < 32; i++) {
+		p[i] = i;
+	}
+	p2 = sys_heap_realloc(&heap, p, 256);
+	zassert_equal_ptr(p, p2, "grow did not happen in place");
+	zassert_true(sys_heap_validate(&heap), "");
+
+	/* Shrinking always stays in place and frees the tail */
+	p2 = sys_heap_realloc(&heap, p, 16);
+	zassert_equal_ptr(p, p2, "shrink did not happen in place");
+	blocker = sys_heap_alloc(&heap, 16);
+	zassert_true(blocker > p && blocker < p + 64,
+		     "shrunk tail was not reused");
+	zassert_true(sys_heap_validate(&heap), "");
+
+	/* With a used neighbor the block moves, keeping its data */
+	p2 = sys_heap_realloc(&heap, p, 128);
+	zassert_not_null(p2, "");
+	zassert_not_equal(p, p2, "block did not move");
+	for (int i = 0; i < 16; i++) {
+		zassert_equal(p2[i], i, "data not preserved");
+	}
+	zassert_true(sys_heap_validate(&heap), "");
+
+	/* A failed realloc leaves the block intact */
+	zassert_is_null(sys_heap_realloc(&heap, p2, 4 * SMALL_HEAP_SZ), "");
+	for (int i = 0; i < 16; i++) {
+		zassert_equal(p2[i], i, "data not preserved");
+	}
+
+	sys_heap_free(&heap, p2);
+	sys_heap_free(&heap, blocker);
+	zassert_true(sys_heap_validate(&heap), "");
+}
+
+static void test_runtime_stats(void)
+{
+	struct sys_heap heap;
+	struct sys_heap_runtime_stats st;
+	size_t total;
+	void *p[4];
+
+	sys_heap_init(&heap, heapmem, SMALL_HEAP_SZ);
+	sys_heap_runtime_stats_get(&heap, &st);
+	total = st.free_bytes;
+	zassert_equal(st.allocated_bytes, 0, "");
+	zassert_equal(st.largest_free_bytes, total, "");
+	zassert_equal(st.free_chunks, 1, "");
+	zassert_equal(st.fragmentation, 0, "");
+
+	for (int i = 0; i < ARRAY_SIZE(p); i++) {
+		p[i] = sys_heap_alloc(&heap, 100);
+	}
+	sys_heap_runtime_stats_get(&heap, &st);
+	zassert_true(st.allocated_bytes >= 4 * 100, "");
+	zassert_equal(st.allocated_bytes + st.free_bytes, total, "");
+	zassert_equal(st.max_allocated_bytes, st.allocated_bytes, "");
+
+	/* Punch a hole: the free space is now in two pieces */
+	sys_heap_free(&heap, p[1]);
+	p[1] = sys_heap_realloc(&heap, p[0], 300);
+	zassert_not_equal(p[1], p[0], "");
+	sys_heap_runtime_stats_get(&heap, &st);
+	zassert_equal(st.allocated_bytes + st.free_bytes, total, "");
+	zassert_true(st.max_allocated_bytes > st.allocated_bytes, "");
+	zassert_equal(st.free_chunks, 2, "");
+	zassert_true(st.largest_free_bytes < st.free_bytes, "");
+	zassert_true(st.fragmentation > 0, "");
+
+	sys_heap_runtime_stats_reset_max(&heap);
+	sys_heap_runtime_stats_get(&heap, &st);
+	zassert_equal(st.max_allocated_bytes, st.allocated_bytes, "");
+
+	for (int i = 1; i < ARRAY_SIZE(p); i++) {
+		sys_heap_free(&heap, p[i]);
+	}
+	sys_heap_runtime_stats_get(&heap, &st);
+	zassert_equal(st.allocated_bytes, 0, "");
+	zassert_equal(st.free_bytes, total, "");
+}
+
+static void *benchalloc(void *arg, size_t bytes)
+{
+	return sys_heap_alloc(arg, bytes);
+}
+
+static void benchfree(void *arg, void *p)
+{
+	sys_heap_free(arg, p);
+}
+
+/* Not a correctness test: reports the cost of the allocator without
+ * validation overhead, for a steady churn of a few small fixed sizes
+ * (the size class fast path) and for the random stress workload, and
+ * how full the heap gets before allocations start failing.
+ */
+static void test_throughput(void)
+{
+	static void *blocks[256];
+	static const size_t sizes[] = { 8, 16, 24, 32 };
+	struct sys_heap heap;
+	struct z_heap_stress_result result;
+	u32_t t0, cycles;
+	size_t n = 0, reused = 0;
+
+	sys_heap_init(&heap, heapmem, SMALL_HEAP_SZ);
+
+	t0 = k_cycle_get_32();
+	for (int i = 0; i < ITERATION_COUNT / 64; i++) {
+		for (int j = 0; j < 64; j++) {
+			blocks[j] = sys_heap_alloc(&heap,
+						   sizes[j % ARRAY_SIZE(sizes)]);
+		}
+		for (int j = 0; j < 64; j++) {
+			sys_heap_free(&heap, blocks[j]);
+		}
+	}
+	cycles = k_cycle_get_32() - t0;
+	TC_PRINT("small blocks: %u cycles per alloc+free\n",
+		 (u32_t)(cycles / ITERATION_COUNT));
+
+	sys_heap_init(&heap, heapmem, SMALL_HEAP_SZ);
+	t0 = k_cycle_get_32();
+	sys_heap_stress(benchalloc, benchfree, &heap,
+			SMALL_HEAP_SZ, ITERATION_COUNT,
+			scratchmem, sizeof(scratchmem),
+			100, &result);
+	cycles = k_cycle_get_32() - t0;
+	TC_PRINT("stress: %u cycles per op\n", (u32_t)(cycles /
+		 (result.total_allocs + result.total_frees)));
+	log_result(SMALL_HEAP_SZ, &result);
+
+	/* Fragmentation: fill a fresh heap with 16 byte blocks, free
+	 * every other one and count how many of the freed bytes can
+	 * still be allocated as 8 byte blocks.
+	 */
+	sys_heap_init(&heap, heapmem, SMALL_HEAP_SZ);
+	while (n < ARRAY_SIZE(blocks) &&
+	       (blocks[n] = sys_heap_alloc(&heap, 16)) != NULL) {
+		n++;
+	}
+	for (int i = 0; i < n; i += 2) {
+		sys_heap_free(&heap, blocks[i]);
+	}
+	for (int i = 0; i < n; i += 2) {
+		blocks[i] = sys_heap_alloc(&heap, 8);
+		if (blocks[i] == NULL) {
+			break;
+		}
+		reused += 8;
+	}
+	zassert_true(sys_heap_validate(&heap), "");
+	TC_PRINT("fragmentation: %u of %u freed bytes reusable\n",
+		 (u32_t)reused, (u32_t)(16 * ((n + 1) / 2)));
+}
+
 void test_main(void)
 {
 	ztest_test_suite(lib_heap_test,
 			 ztest_unit_test(test_small_heap),
 			 ztest_unit_test(test_fragmentation),
-			 ztest_unit_test(test_big_heap)
+			 ztest_unit_test(test_big_heap),
+			 ztest_unit_test(test_aligned_alloc),
+			 ztest_unit_test(test_realloc),
+			 ztest_unit_test(test_runtime_stats),
+			 ztest_unit_test(test_throughput)
 			 );
 
 	ztest_run_test_suite(lib_heap_test);
@@ -8,6 +8,7 @@
 #include <stdbool.h>
 #include <ztest.h>
 #include <data/json.h>
+#include <net/buf.h>
 
 struct test_nested {
 	int nested_int;
@@ -539,6 +540,206 @@ static void test_json_encode_bounds_check(void)
 	zassert_equal(ret, -ENOMEM, "Bounds check rejected");
 }
 
+struct stream_log {
+	char text[512];
+	size_t len;
+	int abort_at;
+};
+
+static void stream_log_add(struct stream_log *log, const char *str,
+			   size_t len)
+{
+	zassert_true(len < sizeof(log->text) - log->len, "log too small");
+	memcpy(log->text + log->len, str, len);
+	log->len += len;
+	log->text[log->len] = '\0';
+}
+
+/* Logs each token as "<type><depth> <path> <key>=<value>;" */
+static int stream_log_token(const struct json_stream_token *token,
+			    void *user_data)
+{
+	struct stream_log *log = user_data;
+	char head[2] = { token->type, '0' + token->depth };
+
+	if (log->abort_at-- == 0) {
+		return -ECANCELED;
+	}
+
+	stream_log_add(log, head, sizeof(head));
+	stream_log_add(log, " ", 1);
+	stream_log_add(log, token->path, token->path_len);
+	stream_log_add(log, " ", 1);
+	if (token->key) {
+		stream_log_add(log, token->key, token->key_len);
+	}
+	stream_log_add(log, "=", 1);
+	stream_log_add(log, token->value, token->value_len);
+	stream_log_add(log, ";", 1);
+
+	return 0;
+}
+
+static int stream_parse(const char *json, size_t chunk, size_t buf_size,
+			struct stream_log *log)
+{
+	struct json_stream stream;
+	char buf[64];
+	size_t len = strlen(json);
+	size_t pos;
+	int ret;
+
+	zassert_true(buf_size <= sizeof(buf), NULL);
+	memset(log, 0, sizeof(*log));
+	log->abort_at = -1;
+	json_stream_init(&stream, buf, buf_size, stream_log_token, log);
+
+	for (pos = 0; pos < len; pos += chunk) {
+		ret = json_stream_feed(&stream, json + pos,
+				       MIN(chunk, len - pos));
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return json_stream_finish(&stream);
+}
+
+static void test_json_stream(void)
+{
+	const char *json = " {\"name\": \"t\\\"1\", \"vals\" : [1, -2.5e3, "
+		"{\"ok\":true}, [], null], \"o\":{}, \"f\":false}\n";
+	const char *expected =
+		"{0  =;"
+		"\"1 /name name=t\\\"1;"
+		"[1 /vals vals=;"
+		"02 /vals/0 =1;"
+		"02 /vals/1 =-2.5e3;"
+		"{2 /vals/2 =;"
+		"t3 /vals/2/ok ok=;"
+		"}2 /vals/2 =;"
+		"[2 /vals/3 =;"
+		"]2 /vals/3 =;"
+		"n2 /vals/4 =;"
+		"]1 /vals vals=;"
+		"{1 /o o=;"
+		"}1 /o o=;"
+		"f1 /f f=;"
+		"}0  =;";
+	struct stream_log log;
+	size_t chunk;
+	int ret;
+
+	/* TESTPOINT: the document is parsed the same way whatever the
+	 * chunks it is split in
+	 */
+	for (chunk = 1; chunk <= strlen(json); chunk++) {
+		ret = stream_parse(json, chunk, 64, &log);
+		zassert_equal(ret, 0, "chunk %u: error %d", chunk, ret);
+		zassert_true(!strcmp(log.text, expected),
+			     "chunk %u: %s", chunk, log.text);
+	}
+
+	/* TESTPOINT: any value can be at the top level, numbers are only
+	 * complete at the end of the document
+	 */
+	zassert_equal(stream_parse("42", 1, 64, &log), 0, NULL);
+	zassert_true(!strcmp(log.text, "00  =42;"), "%s", log.text);
+	zassert_equal(stream_parse("\"s\"", 1, 64, &log), 0, NULL);
+	zassert_true(!strcmp(log.text, "\"0  =s;"), "%s", log.text);
+}
+
+static void test_json_stream_errors(void)
+{
+	struct stream_log log;
+
+	zassert_equal(stream_parse("{\"a\":1,}", 3, 64, &log), -EINVAL, NULL);
+	zassert_equal(stream_parse("{\"a\" 1}", 3, 64, &log), -EINVAL, NULL);
+	zassert_equal(stream_parse("[1]]", 3, 64, &log), -EINVAL, NULL);
+	zassert_equal(stream_parse("[1}", 3, 64, &log), -EINVAL, NULL);
+	zassert_equal(stream_parse("[tru]", 3, 64, &log), -EINVAL, NULL);
+	zassert_equal(stream_parse("[\"\\x\"]", 3, 64, &log), -EINVAL,
+		      NULL);
+	zassert_equal(stream_parse("[\"\\u12g4\"]", 3, 64, &log), -EINVAL,
+		      NULL);
+	zassert_equal(stream_parse("{} {}", 3, 64, &log), -EINVAL, NULL);
+
+	/* TESTPOINT: truncated documents are detected at the end */
+	zassert_equal(stream_parse("{\"a\":[1", 3, 64, &log), -EINVAL, NULL);
+	zassert_equal(stream_parse("", 3, 64, &log), -EINVAL, NULL);
+
+	/* TESTPOINT: the scratch buffer must hold the path and value */
+	zassert_equal(stream_parse("{\"abc\":\"defg\"}", 3, 8, &log), 0,
+		      NULL);
+	zassert_equal(stream_parse("{\"abc\":\"defgh\"}", 3, 8, &log),
+		      -ENOMEM, NULL);
+	zassert_equal(stream_parse("[[[[[[[[[[[[[[[[[]]]]]]]]]]]]]]]]]", 3,
+				   64, &log), -ENOMEM, NULL);
+
+	/* TESTPOINT: callback errors abort the parser for good */
+	{
+		struct json_stream stream;
+		char buf[16];
+
+		memset(&log, 0, sizeof(log));
+		log.abort_at = 1;
+		json_stream_init(&stream, buf, sizeof(buf), stream_log_token,
+				 &log);
+		zassert_equal(json_stream_feed(&stream, "[1, 2]", 6),
+			      -ECANCELED, NULL);
+		zassert_equal(json_stream_feed(&stream, "", 0), -ECANCELED,
+			      NULL);
+		zassert_equal(json_stream_finish(&stream), -ECANCELED, NULL);
+	}
+}
+
+NET_BUF_POOL_DEFINE(json_pool, 4, 32, 0, NULL);
+
+static void test_json_encode_net_buf(void)
+{
+	struct test_nested nested = {
+		.nested_int = -2147483647 - 1,
+		.nested_bool = true,
+		.nested_string = "tab\there",
+	};
+	const char *expected = "head{\"nested_int\":-2147483648,"
+		"\"nested_bool\":true,\"nested_string\":\"tab\\there\"}";
+	char out[128];
+	struct net_buf *buf, *frag;
+	size_t len = 0;
+	int ret;
+
+	buf = net_buf_alloc(&json_pool, K_NO_WAIT);
+	zassert_not_null(buf, NULL);
+	net_buf_add_mem(buf, "head", 4);
+
+	/* TESTPOINT: too little room in the chain */
+	ret = json_obj_encode_net_buf(nested_descr, ARRAY_SIZE(nested_descr),
+				      &nested, buf);
+	zassert_equal(ret, -ENOMEM, NULL);
+
+	net_buf_frag_del(NULL, buf);
+	buf = net_buf_alloc(&json_pool, K_NO_WAIT);
+	net_buf_add_mem(buf, "head", 4);
+	for (int i = 0; i < 3; i++) {
+		net_buf_frag_add(buf, net_buf_alloc(&json_pool, K_NO_WAIT));
+	}
+
+	/* TESTPOINT: the object spans fragments, after the existing data */
+	ret = json_obj_encode_net_buf(nested_descr, ARRAY_SIZE(nested_descr),
+				      &nested, buf);
+	zassert_equal(ret, 0, NULL);
+
+	for (frag = buf; frag; frag = frag->frags) {
+		memcpy(out + len, frag->data, frag->len);
+		len += frag->len;
+	}
+	out[len] = '\0';
+	zassert_true(!strcmp(out, expected), "%s", out);
+
+	net_buf_unref(buf);
+}
+
 void test_main(void)
 {
 	ztest_test_suite(lib_json_test,
@@ -560,7 +761,10 @@ void test_main(void)
 			 ztest_unit_test(test_json_escape_empty),
 			 ztest_unit_test(test_json_escape_no_op),
 			 ztest_unit_test(test_json_escape_bounds_check),
-			 ztest_unit_test(test_json_encode_bounds_check)
+			 ztest_unit_test(test_json_encode_bounds_check),
+			 ztest_unit_test(test_json_stream),
+			 ztest_unit_test(test_json_stream_errors),
+			 ztest_unit_test(test_json_encode_net_buf)
 			 );
 
 	ztest_run_test_suite(lib_json_test);
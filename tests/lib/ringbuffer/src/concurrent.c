@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <sys/ring_buffer.h>
+
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
+
+#define SPSC_BYTES (256 * 1024)
+#define SPSC_SIZE 251
+
+#define MPSC_PRODUCERS 3
+#define MPSC_RECORDS 4000
+#define MPSC_ISR_RECORDS 50
+#define MPSC_SIZE 256
+
+/* A multi-producer record, written and read as a whole */
+struct record {
+	u8_t id;
+	u8_t check;
+	u16_t seq;
+};
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, MPSC_PRODUCERS, STACK_SIZE);
+static struct k_thread threads[MPSC_PRODUCERS];
+
+RING_BUF_DECLARE(spsc_buf, SPSC_SIZE);
+RING_BUF_MPSC_DECLARE(mpsc_buf, MPSC_SIZE);
+
+static volatile u16_t isr_seq;
+
+static void report(const char *name, u32_t bytes, u32_t start)
+{
+	u32_t ms = MAX(k_uptime_get_32() - start, 1U);
+
+	TC_PRINT("%s: %u bytes in %u ms, %u KiB/s\n", name, bytes, ms,
+		 (bytes / ms) * 1000U / 1024U);
+}
+
+static void spsc_producer(void *p1, void *p2, void *p3)
+{
+	u32_t sent = 0U;
+	u32_t chunk = 1U;
+	u32_t granted, i;
+	u8_t *data;
+
+	while (sent < SPSC_BYTES) {
+		granted = ring_buf_put_claim(&spsc_buf, &data,
+					     MIN(chunk, SPSC_BYTES - sent));
+		if (granted == 0U) {
+			k_yield();
+			continue;
+		}
+
+		for (i = 0U; i < granted; i++) {
+			data[i] = (u8_t)(sent + i);
+		}
+
+		zassert_equal(ring_buf_put_finish(&spsc_buf, granted), 0, NULL);
+		sent += granted;
+		chunk = (chunk % 61U) + 1U;
+	}
+}
+
+/**
+ * @brief Test a ring buffer shared by a producer and a consumer thread
+ *
+ * A producer thread writes a byte sequence in chunks of varying sizes,
+ * while the test thread reads it back without either side taking a
+ * lock. On SMP, both threads run in parallel on different CPUs.
+ *
+ * @see ring_buf_put_claim(), ring_buf_put_finish(),
+ * ring_buf_get_claim(), ring_buf_get_finish()
+ */
+void test_ringbuffer_spsc_stress(void)
+{
+	u32_t received = 0U;
+	u32_t chunk = 1U;
+	u32_t start, granted, i;
+	u8_t *data;
+
+	start = k_uptime_get_32();
+	k_thread_create(&threads[0], stacks[0], STACK_SIZE,
+			spsc_producer, NULL, NULL, NULL,
+			k_thread_priority_get(k_current_get()), 0, K_NO_WAIT);
+
+	while (received < SPSC_BYTES) {
+		granted = ring_buf_get_claim(&spsc_buf, &data, chunk);
+		if (granted == 0U) {
+			k_yield();
+			continue;
+		}
+
+		for (i = 0U; i < granted; i++) {
+			zassert_equal(data[i], (u8_t)(received + i),
+				      "corrupted byte at %u", received + i);
+		}
+
+		zassert_equal(ring_buf_get_finish(&spsc_buf, granted), 0, NULL);
+		received += granted;
+		chunk = (chunk % 53U) + 1U;
+	}
+
+	k_thread_join(&threads[0], K_FOREVER);
+	zassert_true(ring_buf_is_empty(&spsc_buf), NULL);
+	report("spsc", received, start);
+}
+
+static bool mpsc_put(u8_t id, u16_t seq)
+{
+	struct record rec = {
+		.id = id,
+		.check = (u8_t)(id ^ seq ^ (seq >> 8)),
+		.seq = seq,
+	};
+	u8_t *data;
+	u32_t granted;
+
+	granted = ring_buf_mpsc_put_claim(&mpsc_buf, &data, sizeof(rec));
+	if (granted < sizeof(rec)) {
+		ring_buf_mpsc_put_finish(&mpsc_buf, 0);
+		return false;
+	}
+
+	memcpy(data, &rec, sizeof(rec));
+	zassert_equal(ring_buf_mpsc_put_finish(&mpsc_buf, sizeof(rec)), 0,
+		      NULL);
+	return true;
+}
+
+static void mpsc_producer(void *p1, void *p2, void *p3)
+{
+	u8_t id = POINTER_TO_INT(p1);
+	u16_t seq = 0U;
+
+	while (seq < MPSC_RECORDS) {
+		if (mpsc_put(id, seq)) {
+			seq++;
+		} else {
+			k_yield();
+		}
+	}
+}
+
+static void mpsc_timer_expire(struct k_timer *timer)
+{
+	if (isr_seq < MPSC_ISR_RECORDS && mpsc_put(MPSC_PRODUCERS, isr_seq)) {
+		isr_seq++;
+	}
+}
+
+K_TIMER_DEFINE(mpsc_timer, mpsc_timer_expire, NULL);
+
+/**
+ * @brief Test a ring buffer written by several threads and an ISR
+ *
+ * Producer threads and a timer ISR write records to a multi-producer
+ * ring buffer, while the test thread reads them and checks that each
+ * record is intact and that each producer's records arrive in order.
+ * The throughput reported is the one of the producer threads.
+ *
+ * @see ring_buf_mpsc_put_claim(), ring_buf_mpsc_put_finish()
+ */
+void test_ringbuffer_mpsc_stress(void)
+{
+	u16_t next_seq[MPSC_PRODUCERS + 1] = { 0 };
+	u32_t total = MPSC_PRODUCERS * MPSC_RECORDS + MPSC_ISR_RECORDS;
+	u32_t received = 0U;
+	u32_t thread_records = 0U;
+	struct record rec;
+	u32_t start;
+	int prio = k_thread_priority_get(k_current_get());
+	int i;
+
+	zassert_equal(MPSC_SIZE % sizeof(rec), 0, NULL);
+
+	start = k_uptime_get_32();
+	for (i = 0; i < MPSC_PRODUCERS; i++) {
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE,
+				mpsc_producer, INT_TO_POINTER(i), NULL, NULL,
+				prio, 0, K_NO_WAIT);
+	}
+	k_timer_start(&mpsc_timer, K_MSEC(1), K_MSEC(1));
+
+	while (received < total) {
+		if (ring_buf_get(&mpsc_buf.rb, (u8_t *)&rec,
+				 sizeof(rec)) == 0U) {
+			/* Only the timer is left, let time pass */
+			if (thread_records == MPSC_PRODUCERS * MPSC_RECORDS) {
+				k_msleep(1);
+			} else {
+				k_yield();
+			}
+			continue;
+		}
+
+		zassert_true(rec.id <= MPSC_PRODUCERS, "bad producer %u",
+			     rec.id);
+		zassert_equal(rec.check,
+			      (u8_t)(rec.id ^ rec.seq ^ (rec.seq >> 8)),
+			      "corrupted record");
+		zassert_equal(rec.seq, next_seq[rec.id],
+			      "producer %u out of order", rec.id);
+		next_seq[rec.id]++;
+		received++;
+
+		if (rec.id < MPSC_PRODUCERS &&
+		    ++thread_records == MPSC_PRODUCERS * MPSC_RECORDS) {
+			report("mpsc", thread_records * sizeof(rec), start);
+		}
+	}
+
+	k_timer_stop(&mpsc_timer);
+	for (i = 0; i < MPSC_PRODUCERS; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+
+	zassert_true(ring_buf_is_empty(&mpsc_buf.rb), NULL);
+}
@@ -443,6 +443,9 @@ void test_reset(void)
 	zassert_true(granted == RINGBUFFER_SIZE - 1, NULL);
 }
 
+extern void test_ringbuffer_spsc_stress(void);
+extern void test_ringbuffer_mpsc_stress(void);
+
 /*test case main entry*/
 void test_main(void)
 {
@@ -461,7 +464,9 @@ void test_main(void)
 			 ztest_unit_test(test_byte_put_free),
 			 ztest_unit_test(test_byte_put_free),
 			 ztest_unit_test(test_capacity),
-			 ztest_unit_test(test_reset)
+			 ztest_unit_test(test_reset),
+			 ztest_unit_test(test_ringbuffer_spsc_stress),
+			 ztest_unit_test(test_ringbuffer_mpsc_stress)
 			 );
 	ztest_run_test_suite(test_ringbuffer_api);
 }
@@ -17,10 +17,23 @@ void test_crc32_ieee(void)
 	u8_t test1[] = { 'A' };
 	u8_t test2[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
 	u8_t test3[] = { 'Z', 'e', 'p', 'h', 'y', 'r' };
+	u8_t test4[256];
+	u32_t crc;
+
+	for (int i = 0; i < sizeof(test4); i++) {
+		test4[i] = i;
+	}
 
 	zassert_equal(crc32_ieee(test1, sizeof(test1)), 0xD3D99E8B, NULL);
 	zassert_equal(crc32_ieee(test2, sizeof(test2)), 0xCBF43926, NULL);
 	zassert_equal(crc32_ieee(test3, sizeof(test3)), 0x20089AA4, NULL);
+	zassert_equal(crc32_ieee(test4, sizeof(test4)), 0x29058C73, NULL);
+
+	/* Updating in pieces at unaligned offsets gives the same result */
+	crc = crc32_ieee_update(0, test4, 13);
+	crc = crc32_ieee_update(crc, &test4[13], 100);
+	crc = crc32_ieee_update(crc, &test4[113], sizeof(test4) - 113);
+	zassert_equal(crc, 0x29058C73, NULL);
 }
 
 void test_crc16(void)
@@ -92,9 +105,16 @@ void test_crc16_ccitt_for_ppp(void)
 void test_crc16_itu_t(void)
 {
 	u8_t test2[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+	u8_t test4[256];
+
+	for (int i = 0; i < sizeof(test4); i++) {
+		test4[i] = i;
+	}
 
 	zassert_equal(crc16_itu_t(0, test2, sizeof(test2)),
 		      0x31c3, NULL);
+	zassert_equal(crc16_itu_t(0, test4, sizeof(test4)), 0x7e55, NULL);
+	zassert_equal(crc16_ccitt(0, test4, sizeof(test4)), 0xd841, NULL);
 }
 
 void test_crc8_ccitt(void)